@@ -176,7 +176,7 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, co
 	EventGroup_t *pxEventBits;
 
 		/* Allocate the event group. */
-		pxEventBits = ( EventGroup_t * ) pvPortMalloc( sizeof( EventGroup_t ) );
+		pxEventBits = ( EventGroup_t * ) pvPortMallocWithHint( sizeof( EventGroup_t ), portHEAP_HINT_CPU );
 
 		if( pxEventBits != NULL )
 		{
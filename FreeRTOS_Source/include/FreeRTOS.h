@@ -100,6 +100,13 @@ extern "C" {
 /* Basic FreeRTOS definitions. */
 #include "projdefs.h"
 
+/* Must be defaulted before portable.h uses it.  Set to 1 to have heap_5.c
+place allocations by the hint passed to pvPortMallocWithHint(), see
+portable.h. */
+#ifndef configUSE_HEAP_HINTS
+	#define configUSE_HEAP_HINTS 0
+#endif
+
 /* Definitions specific to the port being used. */
 #include "portable.h"
 
@@ -296,6 +303,40 @@ extern "C" {
 
 #endif /* configUSE_TIMERS */
 
+#ifndef configUSE_TIMER_WHEEL
+	/* Set to 1 to keep active software timers in a hierarchical timing wheel
+	rather than the sorted active timer lists, see timers.c. */
+	#define configUSE_TIMER_WHEEL 0
+#endif
+
+#if ( configUSE_TIMER_WHEEL == 1 ) && ( configUSE_16_BIT_TICKS == 1 )
+	#error configUSE_TIMER_WHEEL requires 32-bit ticks.
+#endif
+
+#ifndef configUSE_TREE_INDEXED_LISTS
+	/* Set to 1 to index the items vListInsert() places in a list with a
+	red-black tree, so sorted insertion is O(log n) instead of a linear walk,
+	see list.c. */
+	#define configUSE_TREE_INDEXED_LISTS 0
+#endif
+
+#ifndef configUSE_EDF_SCHEDULING
+	/* Set to 1 to order the ready tasks of priority configEDF_PRIORITY by the
+	absolute deadline set with vTaskSetDeadline() instead of round robin, see
+	tasks.c. */
+	#define configUSE_EDF_SCHEDULING 0
+#endif
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+	#ifndef configEDF_PRIORITY
+		#error configEDF_PRIORITY must be defined to the priority of the deadline scheduled tasks when configUSE_EDF_SCHEDULING is 1.
+	#endif
+
+	#if ( configEDF_PRIORITY >= configMAX_PRIORITIES )
+		#error configEDF_PRIORITY must be less than configMAX_PRIORITIES.
+	#endif
+#endif
+
 #ifndef portSET_INTERRUPT_MASK_FROM_ISR
 	#define portSET_INTERRUPT_MASK_FROM_ISR() 0
 #endif
@@ -875,6 +916,10 @@ struct xSTATIC_LIST_ITEM
 {
 	TickType_t xDummy1;
 	void *pvDummy2[ 4 ];
+	#if( configUSE_TREE_INDEXED_LISTS == 1 )
+		void *pvDummy3[ 3 ];
+		UBaseType_t uxDummy4;
+	#endif
 };
 typedef struct xSTATIC_LIST_ITEM StaticListItem_t;
 
@@ -892,6 +937,9 @@ typedef struct xSTATIC_LIST
 	UBaseType_t uxDummy1;
 	void *pvDummy2;
 	StaticMiniListItem_t xDummy3;
+	#if( configUSE_TREE_INDEXED_LISTS == 1 )
+		void *pvDummy4;
+	#endif
 } StaticList_t;
 
 /*
@@ -932,6 +980,10 @@ typedef struct xSTATIC_TCB
 	#if ( configUSE_APPLICATION_TASK_TAG == 1 )
 		void			*pxDummy14;
 	#endif
+	#if ( configUSE_EDF_SCHEDULING == 1 )
+		TickType_t		xDummy21;
+		BaseType_t		xDummy22;
+	#endif
 	#if( configNUM_THREAD_LOCAL_STORAGE_POINTERS > 0 )
 		void			*pvDummy15[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];
 	#endif
@@ -186,6 +186,12 @@ struct xLIST_ITEM
 	struct xLIST_ITEM * configLIST_VOLATILE pxPrevious;	/*< Pointer to the previous ListItem_t in the list. */
 	void * pvOwner;										/*< Pointer to the object (normally a TCB) that contains the list item.  There is therefore a two way link between the object containing the list item and the list item itself. */
 	void * configLIST_VOLATILE pvContainer;				/*< Pointer to the list in which this list item is placed (if any). */
+	#if( configUSE_TREE_INDEXED_LISTS == 1 )
+		struct xLIST_ITEM * configLIST_VOLATILE pxTreeParent;	/*< Links of the item in the red-black tree of its list, only used while the item was placed by vListInsert(). */
+		struct xLIST_ITEM * configLIST_VOLATILE pxTreeLeft;
+		struct xLIST_ITEM * configLIST_VOLATILE pxTreeRight;
+		UBaseType_t uxTreeColour;						/*< listTREE_NOT_INDEXED while the item is not in a tree. */
+	#endif
 	listSECOND_LIST_ITEM_INTEGRITY_CHECK_VALUE			/*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
 };
 typedef struct xLIST_ITEM ListItem_t;					/* For some reason lint wants this as two separate definitions. */
@@ -208,6 +214,9 @@ typedef struct xLIST
 	configLIST_VOLATILE UBaseType_t uxNumberOfItems;
 	ListItem_t * configLIST_VOLATILE pxIndex;			/*< Used to walk through the list.  Points to the last item returned by a call to listGET_OWNER_OF_NEXT_ENTRY (). */
 	MiniListItem_t xListEnd;							/*< List item that contains the maximum possible item value meaning it is always at the end of the list and is therefore used as a marker. */
+	#if( configUSE_TREE_INDEXED_LISTS == 1 )
+		ListItem_t * configLIST_VOLATILE pxTreeRoot;	/*< Red-black tree over the items placed by vListInsert(), in the same order as the list. */
+	#endif
 	listSECOND_LIST_INTEGRITY_CHECK_VALUE				/*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
 } List_t;
 
@@ -399,6 +408,13 @@ void vListInitialiseItem( ListItem_t * const pxItem ) PRIVILEGED_FUNCTION;
 /*
  * Insert a list item into a list.  The item will be inserted into the list in
  * a position determined by its item value (descending item value order).
+ * Items of equal value stay in the order they were inserted.
+ *
+ * With configUSE_TREE_INDEXED_LISTS set to 1 the position is found in a
+ * red-black tree over the items of the list that were inserted this way, in
+ * O(log n) rather than by walking the list, and uxListRemove() is O(log n) for
+ * those items.  A list should then either be sorted with vListInsert() or
+ * appended to with vListInsertEnd(), not both.
  *
  * @param pxList The list into which the item is to be inserted.
  *
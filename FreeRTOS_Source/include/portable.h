@@ -149,6 +149,7 @@ typedef struct HeapRegion
 {
 	uint8_t *pucStartAddress;
 	size_t xSizeInBytes;
+	BaseType_t xCpuOnly;	/* pdTRUE for memory no DMA controller can reach, such as the STM32F4 CCM.  Only used with configUSE_HEAP_HINTS. */
 } HeapRegion_t;
 
 /*
@@ -164,6 +165,23 @@ typedef struct HeapRegion
  */
 void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) PRIVILEGED_FUNCTION;
 
+/* Allocation hints for pvPortMallocWithHint(). */
+#define portHEAP_HINT_ANY	( ( BaseType_t ) 0 )	/* DMA reachable regions first, then CPU only regions.  What pvPortMalloc() does. */
+#define portHEAP_HINT_CPU	( ( BaseType_t ) 1 )	/* Memory only the CPU accesses, such as stacks and kernel objects: CPU only regions first, then the others. */
+#define portHEAP_HINT_DMA	( ( BaseType_t ) 2 )	/* Memory a DMA controller accesses: DMA reachable regions only. */
+
+/*
+ * With configUSE_HEAP_HINTS set to 1 heap_5.c places an allocation by the
+ * xHint given, using the xCpuOnly member of the heap regions.  The kernel
+ * allocates its TCBs, stacks, queues and timers with portHEAP_HINT_CPU.  With
+ * configUSE_HEAP_HINTS set to 0 every heap ignores the hint.
+ */
+#if( configUSE_HEAP_HINTS == 1 )
+	void *pvPortMallocWithHint( size_t xWantedSize, BaseType_t xHint ) PRIVILEGED_FUNCTION;
+#else
+	#define pvPortMallocWithHint( xWantedSize, xHint ) pvPortMalloc( xWantedSize )
+#endif
+
 
 /*
  * Map to the memory management routines required for the port.
@@ -174,6 +192,25 @@ void vPortInitialiseBlocks( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetMinimumEverFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 
+/* Used by heap_4.c and heap_6.c to report the state of the heap. */
+typedef struct xHeapStats
+{
+	size_t xAvailableHeapSpaceInBytes;		/* The total heap size currently available - this is the sum of all the free blocks, not the largest block that can be allocated. */
+	size_t xSizeOfLargestFreeBlockInBytes;	/* The maximum size, in bytes, of all the free blocks within the heap at the time vPortGetHeapStats() is called. */
+	size_t xSizeOfSmallestFreeBlockInBytes;	/* The minimum size, in bytes, of all the free blocks within the heap at the time vPortGetHeapStats() is called. */
+	size_t xNumberOfFreeBlocks;				/* The number of free memory blocks within the heap at the time vPortGetHeapStats() is called. */
+	size_t xMinimumEverFreeBytesRemaining;	/* The minimum amount of total free memory (sum of all free blocks) there has been in the heap since the system booted. */
+	size_t xNumberOfSuccessfulAllocations;	/* The number of calls to pvPortMalloc() that have returned a valid memory block. */
+	size_t xNumberOfSuccessfulFrees;		/* The number of calls to vPortFree() that has successfully freed a block of memory. */
+} HeapStats_t;
+
+/*
+ * Fills pxHeapStats with the state of the heap.  The free blocks are walked,
+ * so this takes time proportional to their number.  The fragmentation of the
+ * heap is 1 - ( xSizeOfLargestFreeBlockInBytes / xAvailableHeapSpaceInBytes ).
+ */
+void vPortGetHeapStats( HeapStats_t *pxHeapStats ) PRIVILEGED_FUNCTION;
+
 /*
  * Setup the hardware ready for the scheduler to take control.  This generally
  * sets up a tick interrupt and sets timers for the correct tick frequency.
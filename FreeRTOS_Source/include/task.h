@@ -949,6 +949,46 @@ void vTaskGetInfo( TaskHandle_t xTask, TaskStatus_t *pxTaskStatus, BaseType_t xG
  */
 void vTaskPrioritySet( TaskHandle_t xTask, UBaseType_t uxNewPriority ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <pre>void vTaskSetDeadline( TaskHandle_t xTask, TickType_t xDeadline );</pre>
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 for this function to be
+ * available.  See the configuration section for more information.
+ *
+ * Set the absolute deadline of any task, as a tick count.  The ready tasks of
+ * priority configEDF_PRIORITY run earliest deadline first rather than round
+ * robin.  Tasks of that priority that were never given a deadline run before
+ * every task that was, in FIFO order.  Tasks with equal deadlines also run in
+ * FIFO order, and a task does not give way to an equal deadline by yielding.
+ * Deadlines are compared modulo the tick count, so they must lie within half
+ * the tick range of each other.  Tasks of every other priority are scheduled
+ * as usual above and below configEDF_PRIORITY.
+ *
+ * A context switch will occur before the function returns if the new deadline
+ * makes a ready task earlier than the currently executing task, or the
+ * currently executing task later than another ready task.
+ *
+ * @param xTask Handle to the task for which the deadline is being set.
+ * Passing a NULL handle results in the deadline of the calling task being set.
+ *
+ * @param xDeadline The tick count by which the task should complete.
+ *
+ * Example usage:
+   <pre>
+ void vAFunction( TaskHandle_t xWorker )
+ {
+	 // Give the worker a deadline 100 ticks from now, then let it run at the
+	 // deadline scheduled priority.
+	 vTaskSetDeadline( xWorker, xTaskGetTickCount() + 100 );
+	 vTaskPrioritySet( xWorker, configEDF_PRIORITY );
+ }
+   </pre>
+ * \defgroup vTaskSetDeadline vTaskSetDeadline
+ * \ingroup TaskCtrl
+ */
+void vTaskSetDeadline( TaskHandle_t xTask, TickType_t xDeadline ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * <pre>void vTaskSuspend( TaskHandle_t xTaskToSuspend );</pre>
@@ -72,6 +72,34 @@
 #include "FreeRTOS.h"
 #include "list.h"
 
+#if( configUSE_TREE_INDEXED_LISTS == 1 )
+
+	/* Colours of the red-black tree that indexes the items vListInsert()
+	places in a list.  An item that is not in a tree, because it is not in a
+	list or was added by vListInsertEnd(), is listTREE_NOT_INDEXED. */
+	#define listTREE_NOT_INDEXED	( ( UBaseType_t ) 0U )
+	#define listTREE_RED			( ( UBaseType_t ) 1U )
+	#define listTREE_BLACK			( ( UBaseType_t ) 2U )
+
+	/* A missing child counts as black. */
+	#define listTREE_IS_RED( pxItem )	( ( ( pxItem ) != NULL ) && ( ( pxItem )->uxTreeColour == listTREE_RED ) )
+
+	/*
+	 * Add pxNewListItem to the tree of pxList and return the item it is to be
+	 * placed in front of in the list, the list end if it has the highest value.
+	 */
+	static ListItem_t *prvTreeInsert( List_t * const pxList, ListItem_t * const pxNewListItem ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Remove pxItem from the tree of pxList.
+	 */
+	static void prvTreeErase( List_t * const pxList, ListItem_t * const pxItem ) PRIVILEGED_FUNCTION;
+
+	static void prvTreeRotateLeft( List_t * const pxList, ListItem_t * const pxItem ) PRIVILEGED_FUNCTION;
+	static void prvTreeRotateRight( List_t * const pxList, ListItem_t * const pxItem ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TREE_INDEXED_LISTS */
+
 /*-----------------------------------------------------------
  * PUBLIC LIST API documented in list.h
  *----------------------------------------------------------*/
@@ -94,6 +122,12 @@ void vListInitialise( List_t * const pxList )
 
 	pxList->uxNumberOfItems = ( UBaseType_t ) 0U;
 
+	#if( configUSE_TREE_INDEXED_LISTS == 1 )
+	{
+		pxList->pxTreeRoot = NULL;
+	}
+	#endif
+
 	/* Write known values into the list if
 	configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
 	listSET_LIST_INTEGRITY_CHECK_1_VALUE( pxList );
@@ -106,6 +140,12 @@ void vListInitialiseItem( ListItem_t * const pxItem )
 	/* Make sure the list item is not recorded as being on a list. */
 	pxItem->pvContainer = NULL;
 
+	#if( configUSE_TREE_INDEXED_LISTS == 1 )
+	{
+		pxItem->uxTreeColour = listTREE_NOT_INDEXED;
+	}
+	#endif
+
 	/* Write known values into the list item if
 	configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
 	listSET_FIRST_LIST_ITEM_INTEGRITY_CHECK_VALUE( pxItem );
@@ -160,7 +200,15 @@ const TickType_t xValueOfInsertion = pxNewListItem->xItemValue;
 	stored in ready lists (all of which have the same xItemValue value) get a
 	share of the CPU.  However, if the xItemValue is the same as the back marker
 	the iteration loop below will not end.  Therefore the value is checked
-	first, and the algorithm slightly modified if necessary. */
+	first, and the algorithm slightly modified if necessary.  With
+	configUSE_TREE_INDEXED_LISTS the tree, which also places equal values after
+	each other, gives the position without walking the list. */
+	#if( configUSE_TREE_INDEXED_LISTS == 1 )
+	{
+		pxIterator = prvTreeInsert( pxList, pxNewListItem )->pxPrevious;
+		( void ) xValueOfInsertion;
+	}
+	#else
 	if( xValueOfInsertion == portMAX_DELAY )
 	{
 		pxIterator = pxList->xListEnd.pxPrevious;
@@ -195,6 +243,7 @@ const TickType_t xValueOfInsertion = pxNewListItem->xItemValue;
 			insertion position. */
 		}
 	}
+	#endif /* configUSE_TREE_INDEXED_LISTS */
 
 	pxNewListItem->pxNext = pxIterator->pxNext;
 	pxNewListItem->pxNext->pxPrevious = pxNewListItem;
@@ -215,6 +264,20 @@ UBaseType_t uxListRemove( ListItem_t * const pxItemToRemove )
 item. */
 List_t * const pxList = ( List_t * ) pxItemToRemove->pvContainer;
 
+	#if( configUSE_TREE_INDEXED_LISTS == 1 )
+	{
+		if( pxItemToRemove->uxTreeColour != listTREE_NOT_INDEXED )
+		{
+			prvTreeErase( pxList, pxItemToRemove );
+			pxItemToRemove->uxTreeColour = listTREE_NOT_INDEXED;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
 	pxItemToRemove->pxNext->pxPrevious = pxItemToRemove->pxPrevious;
 	pxItemToRemove->pxPrevious->pxNext = pxItemToRemove->pxNext;
 
@@ -238,3 +301,356 @@ List_t * const pxList = ( List_t * ) pxItemToRemove->pvContainer;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TREE_INDEXED_LISTS == 1 )
+
+	static ListItem_t *prvTreeInsert( List_t * const pxList, ListItem_t * const pxNewListItem )
+	{
+	ListItem_t *pxNode = pxList->pxTreeRoot;
+	ListItem_t *pxParent = NULL;
+	ListItem_t *pxSuccessor = ( ListItem_t * ) &( pxList->xListEnd ); /*lint !e826 !e740 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+	ListItem_t *pxGrandparent;
+	ListItem_t *pxUncle;
+	ListItem_t *pxItem = pxNewListItem;
+	const TickType_t xValueOfInsertion = pxNewListItem->xItemValue;
+
+		/* Descend to a leaf.  Equal values go right so the new item is placed
+		after them.  The last node the descent went left at is the first item
+		with a higher value, the new item is placed in front of it. */
+		while( pxNode != NULL )
+		{
+			pxParent = pxNode;
+
+			if( xValueOfInsertion < pxNode->xItemValue )
+			{
+				pxSuccessor = pxNode;
+				pxNode = pxNode->pxTreeLeft;
+			}
+			else
+			{
+				pxNode = pxNode->pxTreeRight;
+			}
+		}
+
+		pxNewListItem->pxTreeParent = pxParent;
+		pxNewListItem->pxTreeLeft = NULL;
+		pxNewListItem->pxTreeRight = NULL;
+		pxNewListItem->uxTreeColour = listTREE_RED;
+
+		if( pxParent == NULL )
+		{
+			pxList->pxTreeRoot = pxNewListItem;
+		}
+		else if( xValueOfInsertion < pxParent->xItemValue )
+		{
+			pxParent->pxTreeLeft = pxNewListItem;
+		}
+		else
+		{
+			pxParent->pxTreeRight = pxNewListItem;
+		}
+
+		/* Restore the red-black properties, at most two rotations. */
+		while( listTREE_IS_RED( pxItem->pxTreeParent ) )
+		{
+			pxParent = pxItem->pxTreeParent;
+
+			/* A red node is never the root, so the grandparent exists. */
+			pxGrandparent = pxParent->pxTreeParent;
+
+			if( pxParent == pxGrandparent->pxTreeLeft )
+			{
+				pxUncle = pxGrandparent->pxTreeRight;
+
+				if( listTREE_IS_RED( pxUncle ) )
+				{
+					pxParent->uxTreeColour = listTREE_BLACK;
+					pxUncle->uxTreeColour = listTREE_BLACK;
+					pxGrandparent->uxTreeColour = listTREE_RED;
+					pxItem = pxGrandparent;
+				}
+				else
+				{
+					if( pxItem == pxParent->pxTreeRight )
+					{
+						pxItem = pxParent;
+						prvTreeRotateLeft( pxList, pxItem );
+						pxParent = pxItem->pxTreeParent;
+					}
+
+					pxParent->uxTreeColour = listTREE_BLACK;
+					pxGrandparent->uxTreeColour = listTREE_RED;
+					prvTreeRotateRight( pxList, pxGrandparent );
+				}
+			}
+			else
+			{
+				pxUncle = pxGrandparent->pxTreeLeft;
+
+				if( listTREE_IS_RED( pxUncle ) )
+				{
+					pxParent->uxTreeColour = listTREE_BLACK;
+					pxUncle->uxTreeColour = listTREE_BLACK;
+					pxGrandparent->uxTreeColour = listTREE_RED;
+					pxItem = pxGrandparent;
+				}
+				else
+				{
+					if( pxItem == pxParent->pxTreeLeft )
+					{
+						pxItem = pxParent;
+						prvTreeRotateRight( pxList, pxItem );
+						pxParent = pxItem->pxTreeParent;
+					}
+
+					pxParent->uxTreeColour = listTREE_BLACK;
+					pxGrandparent->uxTreeColour = listTREE_RED;
+					prvTreeRotateLeft( pxList, pxGrandparent );
+				}
+			}
+		}
+
+		pxList->pxTreeRoot->uxTreeColour = listTREE_BLACK;
+
+		return pxSuccessor;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvTreeErase( List_t * const pxList, ListItem_t * const pxItem )
+	{
+	ListItem_t *pxChild;
+	ListItem_t *pxParent;
+	ListItem_t *pxReplacement;
+	ListItem_t *pxSibling;
+	UBaseType_t uxRemovedColour;
+
+		if( ( pxItem->pxTreeLeft != NULL ) && ( pxItem->pxTreeRight != NULL ) )
+		{
+			/* Two children: the leftmost node of the right subtree, the next
+			indexed item, takes the place of pxItem and the tree loses a node
+			at the old place of the replacement instead. */
+			pxReplacement = pxItem->pxTreeRight;
+
+			while( pxReplacement->pxTreeLeft != NULL )
+			{
+				pxReplacement = pxReplacement->pxTreeLeft;
+			}
+
+			pxChild = pxReplacement->pxTreeRight;
+			pxParent = pxReplacement->pxTreeParent;
+			uxRemovedColour = pxReplacement->uxTreeColour;
+
+			if( pxParent == pxItem )
+			{
+				pxParent = pxReplacement;
+			}
+			else
+			{
+				if( pxChild != NULL )
+				{
+					pxChild->pxTreeParent = pxParent;
+				}
+
+				pxParent->pxTreeLeft = pxChild;
+				pxReplacement->pxTreeRight = pxItem->pxTreeRight;
+				pxItem->pxTreeRight->pxTreeParent = pxReplacement;
+			}
+
+			pxReplacement->pxTreeParent = pxItem->pxTreeParent;
+			pxReplacement->pxTreeLeft = pxItem->pxTreeLeft;
+			pxItem->pxTreeLeft->pxTreeParent = pxReplacement;
+			pxReplacement->uxTreeColour = pxItem->uxTreeColour;
+
+			if( pxItem->pxTreeParent == NULL )
+			{
+				pxList->pxTreeRoot = pxReplacement;
+			}
+			else if( pxItem->pxTreeParent->pxTreeLeft == pxItem )
+			{
+				pxItem->pxTreeParent->pxTreeLeft = pxReplacement;
+			}
+			else
+			{
+				pxItem->pxTreeParent->pxTreeRight = pxReplacement;
+			}
+		}
+		else
+		{
+			/* At most one child, which takes the place of pxItem. */
+			pxChild = ( pxItem->pxTreeLeft != NULL ) ? pxItem->pxTreeLeft : pxItem->pxTreeRight;
+			pxParent = pxItem->pxTreeParent;
+			uxRemovedColour = pxItem->uxTreeColour;
+
+			if( pxChild != NULL )
+			{
+				pxChild->pxTreeParent = pxParent;
+			}
+
+			if( pxParent == NULL )
+			{
+				pxList->pxTreeRoot = pxChild;
+			}
+			else if( pxParent->pxTreeLeft == pxItem )
+			{
+				pxParent->pxTreeLeft = pxChild;
+			}
+			else
+			{
+				pxParent->pxTreeRight = pxChild;
+			}
+		}
+
+		/* Removing a black node leaves pxChild's side one black short.
+		Restore the red-black properties, at most three rotations. */
+		if( uxRemovedColour == listTREE_BLACK )
+		{
+			while( ( pxChild != pxList->pxTreeRoot ) && ( listTREE_IS_RED( pxChild ) == pdFALSE ) )
+			{
+				if( pxParent->pxTreeLeft == pxChild )
+				{
+					pxSibling = pxParent->pxTreeRight;
+
+					if( listTREE_IS_RED( pxSibling ) )
+					{
+						pxSibling->uxTreeColour = listTREE_BLACK;
+						pxParent->uxTreeColour = listTREE_RED;
+						prvTreeRotateLeft( pxList, pxParent );
+						pxSibling = pxParent->pxTreeRight;
+					}
+
+					if( ( listTREE_IS_RED( pxSibling->pxTreeLeft ) == pdFALSE ) && ( listTREE_IS_RED( pxSibling->pxTreeRight ) == pdFALSE ) )
+					{
+						pxSibling->uxTreeColour = listTREE_RED;
+						pxChild = pxParent;
+						pxParent = pxChild->pxTreeParent;
+					}
+					else
+					{
+						if( listTREE_IS_RED( pxSibling->pxTreeRight ) == pdFALSE )
+						{
+							pxSibling->pxTreeLeft->uxTreeColour = listTREE_BLACK;
+							pxSibling->uxTreeColour = listTREE_RED;
+							prvTreeRotateRight( pxList, pxSibling );
+							pxSibling = pxParent->pxTreeRight;
+						}
+
+						pxSibling->uxTreeColour = pxParent->uxTreeColour;
+						pxParent->uxTreeColour = listTREE_BLACK;
+						pxSibling->pxTreeRight->uxTreeColour = listTREE_BLACK;
+						prvTreeRotateLeft( pxList, pxParent );
+						pxChild = pxList->pxTreeRoot;
+						break;
+					}
+				}
+				else
+				{
+					pxSibling = pxParent->pxTreeLeft;
+
+					if( listTREE_IS_RED( pxSibling ) )
+					{
+						pxSibling->uxTreeColour = listTREE_BLACK;
+						pxParent->uxTreeColour = listTREE_RED;
+						prvTreeRotateRight( pxList, pxParent );
+						pxSibling = pxParent->pxTreeLeft;
+					}
+
+					if( ( listTREE_IS_RED( pxSibling->pxTreeLeft ) == pdFALSE ) && ( listTREE_IS_RED( pxSibling->pxTreeRight ) == pdFALSE ) )
+					{
+						pxSibling->uxTreeColour = listTREE_RED;
+						pxChild = pxParent;
+						pxParent = pxChild->pxTreeParent;
+					}
+					else
+					{
+						if( listTREE_IS_RED( pxSibling->pxTreeLeft ) == pdFALSE )
+						{
+							pxSibling->pxTreeRight->uxTreeColour = listTREE_BLACK;
+							pxSibling->uxTreeColour = listTREE_RED;
+							prvTreeRotateLeft( pxList, pxSibling );
+							pxSibling = pxParent->pxTreeLeft;
+						}
+
+						pxSibling->uxTreeColour = pxParent->uxTreeColour;
+						pxParent->uxTreeColour = listTREE_BLACK;
+						pxSibling->pxTreeLeft->uxTreeColour = listTREE_BLACK;
+						prvTreeRotateRight( pxList, pxParent );
+						pxChild = pxList->pxTreeRoot;
+						break;
+					}
+				}
+			}
+
+			if( pxChild != NULL )
+			{
+				pxChild->uxTreeColour = listTREE_BLACK;
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvTreeRotateLeft( List_t * const pxList, ListItem_t * const pxItem )
+	{
+	ListItem_t * const pxPivot = pxItem->pxTreeRight;
+
+		pxItem->pxTreeRight = pxPivot->pxTreeLeft;
+
+		if( pxPivot->pxTreeLeft != NULL )
+		{
+			pxPivot->pxTreeLeft->pxTreeParent = pxItem;
+		}
+
+		pxPivot->pxTreeParent = pxItem->pxTreeParent;
+
+		if( pxItem->pxTreeParent == NULL )
+		{
+			pxList->pxTreeRoot = pxPivot;
+		}
+		else if( pxItem == pxItem->pxTreeParent->pxTreeLeft )
+		{
+			pxItem->pxTreeParent->pxTreeLeft = pxPivot;
+		}
+		else
+		{
+			pxItem->pxTreeParent->pxTreeRight = pxPivot;
+		}
+
+		pxPivot->pxTreeLeft = pxItem;
+		pxItem->pxTreeParent = pxPivot;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvTreeRotateRight( List_t * const pxList, ListItem_t * const pxItem )
+	{
+	ListItem_t * const pxPivot = pxItem->pxTreeLeft;
+
+		pxItem->pxTreeLeft = pxPivot->pxTreeRight;
+
+		if( pxPivot->pxTreeRight != NULL )
+		{
+			pxPivot->pxTreeRight->pxTreeParent = pxItem;
+		}
+
+		pxPivot->pxTreeParent = pxItem->pxTreeParent;
+
+		if( pxItem->pxTreeParent == NULL )
+		{
+			pxList->pxTreeRoot = pxPivot;
+		}
+		else if( pxItem == pxItem->pxTreeParent->pxTreeRight )
+		{
+			pxItem->pxTreeParent->pxTreeRight = pxPivot;
+		}
+		else
+		{
+			pxItem->pxTreeParent->pxTreeLeft = pxPivot;
+		}
+
+		pxPivot->pxTreeRight = pxItem;
+		pxItem->pxTreeParent = pxPivot;
+	}
+
+#endif /* configUSE_TREE_INDEXED_LISTS */
+
@@ -0,0 +1,480 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*-----------------------------------------------------------
+ * Implementation of functions defined in portable.h for the POSIX (Linux)
+ * simulation port.
+ *
+ * Every FreeRTOS task is backed by a pthread.  Only the thread of the task
+ * selected by the kernel is allowed to run; all the others are parked on a
+ * per-thread event.  A context switch signals the event of the task being
+ * switched in and parks the calling thread on its own event.
+ *
+ * The tick is generated by an ITIMER_REAL interval timer.  SIGALRM (and any
+ * other signal used to simulate a peripheral interrupt) is only ever
+ * unblocked on the thread of the running task, so the tick "interrupt"
+ * always executes in the context of the task it preempts, as on the target.
+ *----------------------------------------------------------*/
+
+/* Standard includes. */
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define portSIG_TICK			SIGALRM
+#define portSIG_RESUME_MAIN		SIGUSR1
+
+/* Binary event used to park and release a task thread. */
+typedef struct THREAD_EVENT
+{
+	pthread_mutex_t xMutex;
+	pthread_cond_t xCond;
+	BaseType_t xSet;
+} ThreadEvent_t;
+
+/* Per task thread state.  Lives at the top of the task's FreeRTOS stack so it
+can be located from the TCB (the first TCB member is the top of stack). */
+typedef struct THREAD
+{
+	pthread_t xPthread;
+	TaskFunction_t pxCode;
+	void *pvParams;
+	volatile BaseType_t xDying;
+	ThreadEvent_t xEvent;
+} Thread_t;
+
+/* Only one task thread runs at any time, so a single nesting count is
+sufficient.  It is saved and restored around every switch. */
+static volatile UBaseType_t uxCriticalNesting = 0;
+static volatile BaseType_t xSchedulerEnd = pdFALSE;
+static pthread_t xMainThread;
+static sigset_t xInterruptSignals;
+static pthread_once_t xSignalsOnce = PTHREAD_ONCE_INIT;
+static volatile BaseType_t xInsideInterrupt = pdFALSE;
+
+static void prvSetupSignals( void );
+static void prvSetupTimerInterrupt( void );
+static void prvSystemTickHandler( int iSignal );
+static void *prvWaitForStart( void *pvParams );
+static void prvSwitchThread( Thread_t *pxThreadToResume, Thread_t *pxThreadToSuspend );
+static void prvEventInit( ThreadEvent_t *pxEvent );
+static void prvEventSignal( ThreadEvent_t *pxEvent );
+static void prvEventWait( ThreadEvent_t *pxEvent );
+static void prvEventDelete( ThreadEvent_t *pxEvent );
+/*-----------------------------------------------------------*/
+
+static Thread_t *prvGetThreadFromTask( TaskHandle_t xTask )
+{
+StackType_t *pxTopOfStack = *( StackType_t ** ) xTask;
+
+	return ( Thread_t * ) ( pxTopOfStack + 1 );
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * See header file for description.
+ */
+StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters )
+{
+Thread_t *pxThread;
+pthread_attr_t xAttr;
+int iRet;
+
+	( void ) pthread_once( &xSignalsOnce, prvSetupSignals );
+
+	/* Reserve room for the thread state at the top of the stack, keeping the
+	returned top of stack below it. */
+	pxThread = ( Thread_t * ) ( ( ( portPOINTER_SIZE_TYPE ) ( pxTopOfStack + 1 ) - sizeof( Thread_t ) ) & ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) );
+	pxTopOfStack = ( StackType_t * ) pxThread - 1;
+
+	pxThread->pxCode = pxCode;
+	pxThread->pvParams = pvParameters;
+	pxThread->xDying = pdFALSE;
+	prvEventInit( &( pxThread->xEvent ) );
+
+	/* The pthread gets its own (host sized) stack, the FreeRTOS stack is only
+	used to hold the thread state. */
+	pthread_attr_init( &xAttr );
+
+	/* Create the thread with the tick masked so it can only ever receive the
+	tick once it has been switched in. */
+	vPortEnterCritical();
+	iRet = pthread_create( &( pxThread->xPthread ), &xAttr, prvWaitForStart, pxThread );
+	vPortExitCritical();
+
+	pthread_attr_destroy( &xAttr );
+	configASSERT( iRet == 0 );
+	( void ) iRet;
+
+	return pxTopOfStack;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvWaitForStart( void *pvParams )
+{
+Thread_t *pxThread = ( Thread_t * ) pvParams;
+
+	prvEventWait( &( pxThread->xEvent ) );
+
+	if( pxThread->xDying != pdFALSE )
+	{
+		return NULL;
+	}
+
+	/* Switched in for the first time. */
+	uxCriticalNesting = 0;
+	vPortEnableInterrupts();
+
+	pxThread->pxCode( pxThread->pvParams );
+
+	/* A function that implements a task must not exit or attempt to return to
+	its caller as there is nothing to return to. */
+	vTaskDelete( NULL );
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortStartScheduler( void )
+{
+sigset_t xSignals;
+int iSignal;
+Thread_t *pxFirstThread;
+
+	xMainThread = pthread_self();
+
+	/* The main thread only waits for vPortEndScheduler() from here on, it
+	must never take the tick or any other simulated interrupt. */
+	( void ) pthread_once( &xSignalsOnce, prvSetupSignals );
+	vPortDisableInterrupts();
+	sigemptyset( &xSignals );
+	sigaddset( &xSignals, portSIG_RESUME_MAIN );
+	pthread_sigmask( SIG_BLOCK, &xSignals, NULL );
+
+	prvSetupTimerInterrupt();
+
+	/* Start the first task. */
+	pxFirstThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+	prvEventSignal( &( pxFirstThread->xEvent ) );
+
+	sigemptyset( &xSignals );
+	sigaddset( &xSignals, portSIG_RESUME_MAIN );
+
+	while( xSchedulerEnd == pdFALSE )
+	{
+		( void ) sigwait( &xSignals, &iSignal );
+	}
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+struct itimerval xItimer;
+
+	memset( &xItimer, 0, sizeof( xItimer ) );
+	( void ) setitimer( ITIMER_REAL, &xItimer, NULL );
+
+	xSchedulerEnd = pdTRUE;
+	( void ) pthread_kill( xMainThread, portSIG_RESUME_MAIN );
+
+	/* The calling task never runs again. */
+	vPortDisableInterrupts();
+	for( ;; )
+	{
+		( void ) pause();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+	if( uxCriticalNesting == 0 )
+	{
+		vPortDisableInterrupts();
+	}
+
+	uxCriticalNesting++;
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+	configASSERT( uxCriticalNesting );
+	uxCriticalNesting--;
+
+	if( uxCriticalNesting == 0 )
+	{
+		vPortEnableInterrupts();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortDisableInterrupts( void )
+{
+	pthread_sigmask( SIG_BLOCK, &xInterruptSignals, NULL );
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnableInterrupts( void )
+{
+	pthread_sigmask( SIG_UNBLOCK, &xInterruptSignals, NULL );
+}
+/*-----------------------------------------------------------*/
+
+/* Like raising BASEPRI, callable from a task as well as from a signal handler.
+Returns pdTRUE if the interrupts were masked already, in which case
+vPortClearInterruptMask() leaves them masked. */
+UBaseType_t uxPortSetInterruptMask( void )
+{
+sigset_t xPreviousSignals;
+
+	pthread_sigmask( SIG_BLOCK, &xInterruptSignals, &xPreviousSignals );
+
+	return ( sigismember( &xPreviousSignals, portSIG_TICK ) == 1 ) ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortClearInterruptMask( UBaseType_t uxSavedInterruptMask )
+{
+	if( uxSavedInterruptMask == pdFALSE )
+	{
+		vPortEnableInterrupts();
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortIsInsideInterrupt( void )
+{
+	return xInsideInterrupt;
+}
+/*-----------------------------------------------------------*/
+
+void vPortYieldFromISR( void )
+{
+Thread_t *pxThreadToSuspend;
+Thread_t *pxThreadToResume;
+
+	pxThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+	vTaskSwitchContext();
+	pxThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+	prvSwitchThread( pxThreadToResume, pxThreadToSuspend );
+}
+/*-----------------------------------------------------------*/
+
+void vPortYield( void )
+{
+	vPortEnterCritical();
+	vPortYieldFromISR();
+	vPortExitCritical();
+}
+/*-----------------------------------------------------------*/
+
+void vPortCancelThread( void *pxTaskToDelete )
+{
+Thread_t *pxThreadToCancel = prvGetThreadFromTask( ( TaskHandle_t ) pxTaskToDelete );
+
+	/* The thread is parked on its event (a task is never cleaned up while it
+	is running), wake it so it can exit and reclaim it. */
+	pxThreadToCancel->xDying = pdTRUE;
+	prvEventSignal( &( pxThreadToCancel->xEvent ) );
+	( void ) pthread_join( pxThreadToCancel->xPthread, NULL );
+	prvEventDelete( &( pxThreadToCancel->xEvent ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSwitchThread( Thread_t *pxThreadToResume, Thread_t *pxThreadToSuspend )
+{
+UBaseType_t uxSavedCriticalNesting;
+
+	if( pxThreadToSuspend != pxThreadToResume )
+	{
+		uxSavedCriticalNesting = uxCriticalNesting;
+
+		prvEventSignal( &( pxThreadToResume->xEvent ) );
+		prvEventWait( &( pxThreadToSuspend->xEvent ) );
+
+		if( pxThreadToSuspend->xDying != pdFALSE )
+		{
+			pthread_exit( NULL );
+		}
+
+		uxCriticalNesting = uxSavedCriticalNesting;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSystemTickHandler( int iSignal )
+{
+Thread_t *pxThreadToSuspend;
+Thread_t *pxThreadToResume;
+int iSavedErrno = errno;
+
+	( void ) iSignal;
+
+	/* The tick is masked while the handler runs, which is the same as being
+	inside a critical section. */
+	uxCriticalNesting++;
+	xInsideInterrupt = pdTRUE;
+
+	pxThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+	if( xTaskIncrementTick() != pdFALSE )
+	{
+		vTaskSwitchContext();
+		pxThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+		xInsideInterrupt = pdFALSE;
+		prvSwitchThread( pxThreadToResume, pxThreadToSuspend );
+	}
+
+	xInsideInterrupt = pdFALSE;
+	uxCriticalNesting--;
+	errno = iSavedErrno;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSetupSignals( void )
+{
+struct sigaction xSigTick;
+
+	sigemptyset( &xInterruptSignals );
+	sigaddset( &xInterruptSignals, portSIG_TICK );
+
+	memset( &xSigTick, 0, sizeof( xSigTick ) );
+	xSigTick.sa_flags = SA_RESTART;
+	xSigTick.sa_handler = prvSystemTickHandler;
+	sigfillset( &xSigTick.sa_mask );
+	( void ) sigaction( portSIG_TICK, &xSigTick, NULL );
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Setup the interval timer to generate the tick interrupts at the required
+ * frequency.
+ */
+static void prvSetupTimerInterrupt( void )
+{
+struct itimerval xItimer;
+const long lMicroSeconds = 1000000L / configTICK_RATE_HZ;
+
+	xItimer.it_interval.tv_sec = lMicroSeconds / 1000000L;
+	xItimer.it_interval.tv_usec = lMicroSeconds % 1000000L;
+	xItimer.it_value = xItimer.it_interval;
+
+	( void ) setitimer( ITIMER_REAL, &xItimer, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventInit( ThreadEvent_t *pxEvent )
+{
+	pthread_mutex_init( &( pxEvent->xMutex ), NULL );
+	pthread_cond_init( &( pxEvent->xCond ), NULL );
+	pxEvent->xSet = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventSignal( ThreadEvent_t *pxEvent )
+{
+	pthread_mutex_lock( &( pxEvent->xMutex ) );
+	pxEvent->xSet = pdTRUE;
+	pthread_cond_signal( &( pxEvent->xCond ) );
+	pthread_mutex_unlock( &( pxEvent->xMutex ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventWait( ThreadEvent_t *pxEvent )
+{
+	pthread_mutex_lock( &( pxEvent->xMutex ) );
+
+	while( pxEvent->xSet == pdFALSE )
+	{
+		pthread_cond_wait( &( pxEvent->xCond ), &( pxEvent->xMutex ) );
+	}
+
+	pxEvent->xSet = pdFALSE;
+	pthread_mutex_unlock( &( pxEvent->xMutex ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventDelete( ThreadEvent_t *pxEvent )
+{
+	pthread_cond_destroy( &( pxEvent->xCond ) );
+	pthread_mutex_destroy( &( pxEvent->xMutex ) );
+}
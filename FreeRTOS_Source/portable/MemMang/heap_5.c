@@ -108,6 +108,17 @@
  *
  * Note 0x80000000 is the lower address so appears in the array first.
  *
+ * With configUSE_HEAP_HINTS set to 1 the xCpuOnly member of HeapRegion_t marks
+ * regions no DMA controller can reach, and pvPortMallocWithHint() chooses the
+ * regions an allocation is placed in:
+ *
+ * portHEAP_HINT_ANY - first fit in the other regions, then in the CPU only
+ *                     regions.  pvPortMalloc() uses this hint.
+ * portHEAP_HINT_CPU - first fit in the CPU only regions, then in the others.
+ *                     The kernel allocates TCBs, stacks, queues and timers
+ *                     with this hint.
+ * portHEAP_HINT_DMA - first fit in the other regions only.
+ *
  */
 #include <stdlib.h>
 
@@ -149,6 +160,23 @@ typedef struct A_BLOCK_LINK
  */
 static void prvInsertBlockIntoFreeList( BlockLink_t *pxBlockToInsert );
 
+#if( configUSE_HEAP_HINTS == 1 )
+
+	/*
+	 * Returns pdTRUE if pxBlock is in a region defined with xCpuOnly set.
+	 */
+	static BaseType_t prvBlockIsCpuOnly( const BlockLink_t *pxBlock );
+
+	/*
+	 * Finds the first free block of at least xWantedSize bytes in the regions
+	 * xHint allows, in the order it prefers them.  Returns pxEnd if there is
+	 * none, otherwise *ppxPreviousBlock is set to the free block in front of
+	 * it.
+	 */
+	static BlockLink_t *prvFindFreeBlock( size_t xWantedSize, BaseType_t xHint, BlockLink_t **ppxPreviousBlock );
+
+#endif /* configUSE_HEAP_HINTS */
+
 /*-----------------------------------------------------------*/
 
 /* The size of the structure placed at the beginning of each allocated memory
@@ -169,9 +197,37 @@ application.  When the bit is free the block is still part of the free heap
 space. */
 static size_t xBlockAllocatedBit = 0;
 
+#if( configUSE_HEAP_HINTS == 1 )
+
+	/* The most regions with xCpuOnly set that vPortDefineHeapRegions() can
+	record. */
+	#define heapMAX_CPU_ONLY_REGIONS	( 4 )
+
+	/* Address range of each CPU only region, from its first block to its end
+	marker. */
+	static size_t xCpuOnlyRegionStart[ heapMAX_CPU_ONLY_REGIONS ];
+	static size_t xCpuOnlyRegionEnd[ heapMAX_CPU_ONLY_REGIONS ];
+	static BaseType_t xCpuOnlyRegions = 0;
+
+#endif /* configUSE_HEAP_HINTS */
+
 /*-----------------------------------------------------------*/
 
-void *pvPortMalloc( size_t xWantedSize )
+#if( configUSE_HEAP_HINTS == 1 )
+
+	void *pvPortMalloc( size_t xWantedSize )
+	{
+		return pvPortMallocWithHint( xWantedSize, portHEAP_HINT_ANY );
+	}
+	/*-----------------------------------------------------------*/
+
+	void *pvPortMallocWithHint( size_t xWantedSize, BaseType_t xHint )
+
+#else
+
+	void *pvPortMalloc( size_t xWantedSize )
+
+#endif /* configUSE_HEAP_HINTS */
 {
 BlockLink_t *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
 void *pvReturn = NULL;
@@ -213,15 +269,23 @@ void *pvReturn = NULL;
 
 			if( ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
 			{
-				/* Traverse the list from the start	(lowest address) block until
-				one	of adequate size is found. */
-				pxPreviousBlock = &xStart;
-				pxBlock = xStart.pxNextFreeBlock;
-				while( ( pxBlock->xBlockSize < xWantedSize ) && ( pxBlock->pxNextFreeBlock != NULL ) )
+				#if( configUSE_HEAP_HINTS == 1 )
+				{
+					pxBlock = prvFindFreeBlock( xWantedSize, xHint, &pxPreviousBlock );
+				}
+				#else
 				{
-					pxPreviousBlock = pxBlock;
-					pxBlock = pxBlock->pxNextFreeBlock;
+					/* Traverse the list from the start	(lowest address) block
+					until one of adequate size is found. */
+					pxPreviousBlock = &xStart;
+					pxBlock = xStart.pxNextFreeBlock;
+					while( ( pxBlock->xBlockSize < xWantedSize ) && ( pxBlock->pxNextFreeBlock != NULL ) )
+					{
+						pxPreviousBlock = pxBlock;
+						pxBlock = pxBlock->pxNextFreeBlock;
+					}
 				}
+				#endif /* configUSE_HEAP_HINTS */
 
 				/* If the end marker was reached then a block of adequate size
 				was	not found. */
@@ -371,6 +435,65 @@ size_t xPortGetMinimumEverFreeHeapSize( void )
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_HEAP_HINTS == 1 )
+
+	static BaseType_t prvBlockIsCpuOnly( const BlockLink_t *pxBlock )
+	{
+	BaseType_t xRegion;
+
+		for( xRegion = 0; xRegion < xCpuOnlyRegions; xRegion++ )
+		{
+			if( ( ( size_t ) pxBlock >= xCpuOnlyRegionStart[ xRegion ] ) && ( ( size_t ) pxBlock < xCpuOnlyRegionEnd[ xRegion ] ) )
+			{
+				return pdTRUE;
+			}
+		}
+
+		return pdFALSE;
+	}
+	/*-----------------------------------------------------------*/
+
+	static BlockLink_t *prvFindFreeBlock( size_t xWantedSize, BaseType_t xHint, BlockLink_t **ppxPreviousBlock )
+	{
+	BlockLink_t *pxBlock, *pxPreviousBlock;
+	BaseType_t xPass, xWantCpuOnly;
+
+		for( xPass = 0; xPass < 2; xPass++ )
+		{
+			/* portHEAP_HINT_CPU looks in the CPU only regions first, the other
+			hints in the other regions. */
+			xWantCpuOnly = ( ( xHint == portHEAP_HINT_CPU ) == ( xPass == 0 ) ) ? pdTRUE : pdFALSE;
+
+			/* Traverse the list from the start	(lowest address) block until
+			one	of adequate size in the wanted kind of region is found. */
+			pxPreviousBlock = &xStart;
+			pxBlock = xStart.pxNextFreeBlock;
+			while( ( ( pxBlock->xBlockSize < xWantedSize ) || ( prvBlockIsCpuOnly( pxBlock ) != xWantCpuOnly ) ) && ( pxBlock->pxNextFreeBlock != NULL ) )
+			{
+				pxPreviousBlock = pxBlock;
+				pxBlock = pxBlock->pxNextFreeBlock;
+			}
+
+			*ppxPreviousBlock = pxPreviousBlock;
+
+			/* Memory for a DMA controller must not fall back to a CPU only
+			region. */
+			if( ( pxBlock != pxEnd ) || ( xHint == portHEAP_HINT_DMA ) )
+			{
+				break;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return pxBlock;
+	}
+	/*-----------------------------------------------------------*/
+
+#endif /* configUSE_HEAP_HINTS */
+
 static void prvInsertBlockIntoFreeList( BlockLink_t *pxBlockToInsert )
 {
 BlockLink_t *pxIterator;
@@ -501,6 +624,27 @@ const HeapRegion_t *pxHeapRegion;
 		pxFirstFreeBlockInRegion->xBlockSize = xAddress - ( size_t ) pxFirstFreeBlockInRegion;
 		pxFirstFreeBlockInRegion->pxNextFreeBlock = pxEnd;
 
+		#if( configUSE_HEAP_HINTS == 1 )
+		{
+			/* Record where the CPU only regions are. */
+			if( pxHeapRegion->xCpuOnly != pdFALSE )
+			{
+				configASSERT( xCpuOnlyRegions < heapMAX_CPU_ONLY_REGIONS );
+
+				if( xCpuOnlyRegions < heapMAX_CPU_ONLY_REGIONS )
+				{
+					xCpuOnlyRegionStart[ xCpuOnlyRegions ] = xAlignedHeap;
+					xCpuOnlyRegionEnd[ xCpuOnlyRegions ] = xAddress;
+					xCpuOnlyRegions++;
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_HEAP_HINTS */
+
 		/* If this is not the first region that makes up the entire heap space
 		then link the previous region to this region. */
 		if( pxPreviousFreeBlock != NULL )
@@ -0,0 +1,660 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * A sample implementation of pvPortMalloc() and vPortFree() that finds a
+ * block and frees it again in constant time, using the two level segregated
+ * fit (TLSF) scheme, and combines (coalescences) adjacent free blocks as
+ * heap_4.c does.
+ *
+ * Free blocks are kept in lists by size class.  The first level class is the
+ * power of two of the block size and each first level class is split into
+ * heapSL_INDEX_COUNT equal second level classes.  A bitmap per level records
+ * which classes hold free blocks, so two bit scans find a free block that is
+ * large enough instead of a walk along a free list.  A request is rounded up
+ * to the start of the next class, which makes every block of the class found
+ * large enough but can leave up to 1 / heapSL_INDEX_COUNT of a request unused.
+ * Every block records the block in front of it in memory, so a freed block is
+ * merged with both its neighbours without searching for them.
+ *
+ * vPortGetHeapStats() reports the free blocks, from which the fragmentation
+ * of the heap can be worked out.
+ *
+ * See heap_1.c, heap_2.c, heap_3.c, heap_4.c and heap_5.c for alternative
+ * implementations, and the memory management pages of http://www.FreeRTOS.org
+ * for more information.
+ */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+	#error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+/* Number of second level classes in each first level class, as a power of
+two.  More classes waste less of each request but need a larger table of free
+lists. */
+#define heapSL_INDEX_COUNT_LOG2		( 3 )
+#define heapSL_INDEX_COUNT			( 1 << heapSL_INDEX_COUNT_LOG2 )
+
+#if( portBYTE_ALIGNMENT == 4 )
+	#define heapALIGNMENT_LOG2		( 2 )
+#elif( portBYTE_ALIGNMENT == 8 )
+	#define heapALIGNMENT_LOG2		( 3 )
+#elif( portBYTE_ALIGNMENT == 16 )
+	#define heapALIGNMENT_LOG2		( 4 )
+#elif( portBYTE_ALIGNMENT == 32 )
+	#define heapALIGNMENT_LOG2		( 5 )
+#else
+	#error heap_6.c does not support this portBYTE_ALIGNMENT
+#endif
+
+/* Blocks smaller than heapSMALL_BLOCK_SIZE all go in first level class 0,
+whose second level classes are portBYTE_ALIGNMENT bytes apart. */
+#define heapFL_INDEX_SHIFT			( heapSL_INDEX_COUNT_LOG2 + heapALIGNMENT_LOG2 )
+#define heapSMALL_BLOCK_SIZE		( ( size_t ) 1 << heapFL_INDEX_SHIFT )
+
+/* floor( log2( x ) ) of a constant below 2^32, so the table of free lists is
+only as large as configTOTAL_HEAP_SIZE needs. */
+#define heapLOG2_2( x )				( ( ( x ) & 0x2UL ) ? 1 : 0 )
+#define heapLOG2_4( x )				( ( ( x ) & 0xCUL ) ? ( 2 + heapLOG2_2( ( x ) >> 2 ) ) : heapLOG2_2( x ) )
+#define heapLOG2_8( x )				( ( ( x ) & 0xF0UL ) ? ( 4 + heapLOG2_4( ( x ) >> 4 ) ) : heapLOG2_4( x ) )
+#define heapLOG2_16( x )			( ( ( x ) & 0xFF00UL ) ? ( 8 + heapLOG2_8( ( x ) >> 8 ) ) : heapLOG2_8( x ) )
+#define heapLOG2( x )				( ( ( x ) & 0xFFFF0000UL ) ? ( 16 + heapLOG2_16( ( x ) >> 16 ) ) : heapLOG2_16( x ) )
+
+/* Class 0 plus one first level class per power of two from
+heapSMALL_BLOCK_SIZE up to the heap size. */
+#define heapFL_INDEX_COUNT			( heapLOG2( configTOTAL_HEAP_SIZE ) - heapFL_INDEX_SHIFT + 2 )
+
+/* Find last set and find first set of a non zero 32-bit value.  Both ports
+in this tree build with GCC, whose builtins compile to CLZ (and RBIT) on the
+Cortex-M4. */
+#define heapFLS( x )				( ( UBaseType_t ) ( 31 - __builtin_clz( ( uint32_t ) ( x ) ) ) )
+#define heapFFS( x )				( ( UBaseType_t ) __builtin_ctz( ( uint32_t ) ( x ) ) )
+
+/* Block sizes are multiples of portBYTE_ALIGNMENT, so bit 0 of xBlockSize is
+free to mark the free blocks. */
+#define heapBLOCK_FREE_BIT			( ( size_t ) 1 )
+#define heapBLOCK_IS_FREE( pxBlock )	( ( ( pxBlock )->xBlockSize & heapBLOCK_FREE_BIT ) != 0 )
+
+/* Allocate the memory for the heap. */
+#if( configAPPLICATION_ALLOCATED_HEAP == 1 )
+	/* The application writer has already defined the array used for the RTOS
+	heap - probably so it can be placed in a special segment or address. */
+	extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#else
+	static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#endif /* configAPPLICATION_ALLOCATED_HEAP */
+
+/* The header at the start of every block.  The free list links are only used
+while the block is free, an allocated block's memory starts where they would
+be. */
+typedef struct A_BLOCK_HEADER
+{
+	struct A_BLOCK_HEADER *pxPreviousPhysicalBlock;	/*<< The block in front of this one in memory, NULL for the first block. */
+	size_t xBlockSize;								/*<< The size of the block, including this header, with heapBLOCK_FREE_BIT set while it is free. */
+	struct A_BLOCK_HEADER *pxNextFreeBlock;			/*<< The next free block of the same class. */
+	struct A_BLOCK_HEADER *pxPreviousFreeBlock;		/*<< The previous free block of the same class. */
+} BlockHeader_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Work out the first and second level class of a block of xBlockSize bytes.
+ */
+static void prvMapSizeToClass( size_t xBlockSize, UBaseType_t *puxFirstLevel, UBaseType_t *puxSecondLevel );
+
+/*
+ * Return a free block of at least xWantedSize bytes, or NULL if there is none
+ * in the classes searched.  The block is still in its free list.
+ */
+static BlockHeader_t *prvFindFreeBlock( size_t xWantedSize );
+
+/*
+ * Add a block to, and take a block out of, the free list of its class.
+ */
+static void prvInsertFreeBlock( BlockHeader_t *pxBlock );
+static void prvRemoveFreeBlock( BlockHeader_t *pxBlock );
+
+/*
+ * Called automatically to setup the required heap structures the first time
+ * pvPortMalloc() is called.
+ */
+static void prvHeapInit( void );
+
+/*-----------------------------------------------------------*/
+
+/* The part of BlockHeader_t in front of every allocated block, correctly byte
+aligned. */
+static const size_t xHeapStructSize = ( ( size_t ) &( ( ( BlockHeader_t * ) 0 )->pxNextFreeBlock ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* A free block must be able to hold a whole BlockHeader_t. */
+static const size_t xMinimumBlockSize = ( sizeof( BlockHeader_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* The free lists of every class and the bitmaps of the classes that are not
+empty. */
+static BlockHeader_t *pxFreeLists[ heapFL_INDEX_COUNT ][ heapSL_INDEX_COUNT ];
+static uint32_t ulFirstLevelBitmap = 0U;
+static uint32_t ulSecondLevelBitmaps[ heapFL_INDEX_COUNT ];
+
+/* Marks the end of the heap, an allocated block of size 0 that is never
+freed. */
+static BlockHeader_t *pxEnd = NULL;
+
+/* Keeps track of the number of free bytes remaining, vPortGetHeapStats()
+reports the fragmentation. */
+static size_t xFreeBytesRemaining = 0U;
+static size_t xMinimumEverFreeBytesRemaining = 0U;
+static size_t xNumberOfSuccessfulAllocations = 0U;
+static size_t xNumberOfSuccessfulFrees = 0U;
+
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+BlockHeader_t *pxBlock, *pxNewBlock;
+void *pvReturn = NULL;
+
+	vTaskSuspendAll();
+	{
+		/* If this is the first call to malloc then the heap will require
+		initialisation to setup the free lists. */
+		if( pxEnd == NULL )
+		{
+			prvHeapInit();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* A request for more than is free cannot succeed, and refusing it
+		first also keeps the additions below from wrapping. */
+		if( ( xWantedSize > 0 ) && ( xWantedSize < xFreeBytesRemaining ) )
+		{
+			/* The wanted size is increased so it can contain the header, and
+			so that blocks are always aligned to the required number of
+			bytes. */
+			xWantedSize += xHeapStructSize;
+
+			if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+			{
+				xWantedSize += ( portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK ) );
+				configASSERT( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) == 0 );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( xWantedSize < xMinimumBlockSize )
+			{
+				xWantedSize = xMinimumBlockSize;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxBlock = prvFindFreeBlock( xWantedSize );
+
+			if( pxBlock != NULL )
+			{
+				/* This block is being returned for use so must be taken out
+				of its free list. */
+				prvRemoveFreeBlock( pxBlock );
+
+				/* If the block is larger than required it can be split into
+				two.  The block behind it cannot be free, as free blocks are
+				always merged, so the remainder goes straight into a free
+				list. */
+				if( ( pxBlock->xBlockSize - xWantedSize ) >= xMinimumBlockSize )
+				{
+					pxNewBlock = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+					configASSERT( ( ( ( size_t ) pxNewBlock ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+					pxNewBlock->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+					pxNewBlock->pxPreviousPhysicalBlock = pxBlock;
+					( ( BlockHeader_t * ) ( ( ( uint8_t * ) pxNewBlock ) + pxNewBlock->xBlockSize ) )->pxPreviousPhysicalBlock = pxNewBlock;
+					pxBlock->xBlockSize = xWantedSize;
+
+					prvInsertFreeBlock( pxNewBlock );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+				if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+				{
+					xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				xNumberOfSuccessfulAllocations++;
+
+				/* Return the memory space pointed to - jumping over the
+				header at its start. */
+				pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceMALLOC( pvReturn, xWantedSize );
+	}
+	( void ) xTaskResumeAll();
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
+	configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+BlockHeader_t *pxBlock, *pxNeighbour;
+
+	if( pv != NULL )
+	{
+		/* The memory being freed will have a header immediately before it. */
+		pxBlock = ( void * ) ( ( ( uint8_t * ) pv ) - xHeapStructSize );
+
+		/* Check the block is actually allocated. */
+		configASSERT( heapBLOCK_IS_FREE( pxBlock ) == pdFALSE );
+		configASSERT( pxBlock->xBlockSize != 0 );
+
+		if( ( heapBLOCK_IS_FREE( pxBlock ) == pdFALSE ) && ( pxBlock->xBlockSize != 0 ) )
+		{
+			vTaskSuspendAll();
+			{
+				xFreeBytesRemaining += pxBlock->xBlockSize;
+				traceFREE( pv, pxBlock->xBlockSize );
+
+				/* Merge with the block behind it if that is free.  pxEnd is
+				never free, so there always is a block behind. */
+				pxNeighbour = ( BlockHeader_t * ) ( ( ( uint8_t * ) pxBlock ) + pxBlock->xBlockSize );
+
+				if( heapBLOCK_IS_FREE( pxNeighbour ) != pdFALSE )
+				{
+					prvRemoveFreeBlock( pxNeighbour );
+					pxBlock->xBlockSize += pxNeighbour->xBlockSize;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* And with the block in front of it. */
+				pxNeighbour = pxBlock->pxPreviousPhysicalBlock;
+
+				if( ( pxNeighbour != NULL ) && ( heapBLOCK_IS_FREE( pxNeighbour ) != pdFALSE ) )
+				{
+					prvRemoveFreeBlock( pxNeighbour );
+					pxNeighbour->xBlockSize += pxBlock->xBlockSize;
+					pxBlock = pxNeighbour;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				( ( BlockHeader_t * ) ( ( ( uint8_t * ) pxBlock ) + pxBlock->xBlockSize ) )->pxPreviousPhysicalBlock = pxBlock;
+				prvInsertFreeBlock( pxBlock );
+				xNumberOfSuccessfulFrees++;
+			}
+			( void ) xTaskResumeAll();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+	return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+	return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t *pxHeapStats )
+{
+BlockHeader_t *pxBlock;
+UBaseType_t uxFirstLevel, uxSecondLevel;
+size_t xBlockSize, xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+
+	vTaskSuspendAll();
+	{
+		for( uxFirstLevel = 0; uxFirstLevel < ( UBaseType_t ) heapFL_INDEX_COUNT; uxFirstLevel++ )
+		{
+			for( uxSecondLevel = 0; uxSecondLevel < ( UBaseType_t ) heapSL_INDEX_COUNT; uxSecondLevel++ )
+			{
+				for( pxBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+				{
+					xBlockSize = pxBlock->xBlockSize & ~heapBLOCK_FREE_BIT;
+					xBlocks++;
+
+					if( xBlockSize > xMaxSize )
+					{
+						xMaxSize = xBlockSize;
+					}
+
+					if( xBlockSize < xMinSize )
+					{
+						xMinSize = xBlockSize;
+					}
+				}
+			}
+		}
+
+		pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+		pxHeapStats->xSizeOfSmallestFreeBlockInBytes = ( xBlocks == 0 ) ? 0 : xMinSize;
+		pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+		pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+		pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+		pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+		pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+	/* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+static void prvMapSizeToClass( size_t xBlockSize, UBaseType_t *puxFirstLevel, UBaseType_t *puxSecondLevel )
+{
+UBaseType_t uxFirstLevel;
+
+	if( xBlockSize < heapSMALL_BLOCK_SIZE )
+	{
+		*puxFirstLevel = 0;
+		*puxSecondLevel = ( UBaseType_t ) ( xBlockSize >> heapALIGNMENT_LOG2 );
+	}
+	else
+	{
+		/* The bits below the top one give the second level class. */
+		uxFirstLevel = heapFLS( xBlockSize );
+		*puxSecondLevel = ( UBaseType_t ) ( xBlockSize >> ( uxFirstLevel - heapSL_INDEX_COUNT_LOG2 ) ) ^ ( UBaseType_t ) heapSL_INDEX_COUNT;
+		*puxFirstLevel = uxFirstLevel - ( heapFL_INDEX_SHIFT - 1 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static BlockHeader_t *prvFindFreeBlock( size_t xWantedSize )
+{
+UBaseType_t uxFirstLevel, uxSecondLevel;
+uint32_t ulBitmap;
+
+	/* Round the size up to the next class, every block from that class on is
+	then large enough.  Small classes hold a single size and need no
+	rounding. */
+	if( xWantedSize >= heapSMALL_BLOCK_SIZE )
+	{
+		xWantedSize += ( ( size_t ) 1 << ( heapFLS( xWantedSize ) - heapSL_INDEX_COUNT_LOG2 ) ) - 1;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	prvMapSizeToClass( xWantedSize, &uxFirstLevel, &uxSecondLevel );
+
+	if( uxFirstLevel >= ( UBaseType_t ) heapFL_INDEX_COUNT )
+	{
+		return NULL;
+	}
+
+	/* A non empty class of the same first level, at or above the second level
+	class of the request. */
+	ulBitmap = ulSecondLevelBitmaps[ uxFirstLevel ] & ( ~( uint32_t ) 0 << uxSecondLevel );
+
+	if( ulBitmap == 0 )
+	{
+		/* Otherwise the smallest non empty class of a higher first level. */
+		ulBitmap = ulFirstLevelBitmap & ( ~( uint32_t ) 0 << ( uxFirstLevel + 1 ) );
+
+		if( ulBitmap == 0 )
+		{
+			return NULL;
+		}
+
+		uxFirstLevel = heapFFS( ulBitmap );
+		ulBitmap = ulSecondLevelBitmaps[ uxFirstLevel ];
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	uxSecondLevel = heapFFS( ulBitmap );
+
+	return pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertFreeBlock( BlockHeader_t *pxBlock )
+{
+UBaseType_t uxFirstLevel, uxSecondLevel;
+BlockHeader_t *pxNext;
+
+	prvMapSizeToClass( pxBlock->xBlockSize, &uxFirstLevel, &uxSecondLevel );
+
+	/* Free blocks go on the front of the list of their class. */
+	pxNext = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+	pxBlock->pxNextFreeBlock = pxNext;
+	pxBlock->pxPreviousFreeBlock = NULL;
+
+	if( pxNext != NULL )
+	{
+		pxNext->pxPreviousFreeBlock = pxBlock;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] = pxBlock;
+	ulFirstLevelBitmap |= ( uint32_t ) 1 << uxFirstLevel;
+	ulSecondLevelBitmaps[ uxFirstLevel ] |= ( uint32_t ) 1 << uxSecondLevel;
+
+	pxBlock->xBlockSize |= heapBLOCK_FREE_BIT;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFreeBlock( BlockHeader_t *pxBlock )
+{
+UBaseType_t uxFirstLevel, uxSecondLevel;
+
+	pxBlock->xBlockSize &= ~heapBLOCK_FREE_BIT;
+	prvMapSizeToClass( pxBlock->xBlockSize, &uxFirstLevel, &uxSecondLevel );
+
+	if( pxBlock->pxNextFreeBlock != NULL )
+	{
+		pxBlock->pxNextFreeBlock->pxPreviousFreeBlock = pxBlock->pxPreviousFreeBlock;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( pxBlock->pxPreviousFreeBlock != NULL )
+	{
+		pxBlock->pxPreviousFreeBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+	}
+	else
+	{
+		/* The block was at the front of its list.  Clear the bitmaps if the
+		list, and then the whole first level class, is now empty. */
+		pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] = pxBlock->pxNextFreeBlock;
+
+		if( pxBlock->pxNextFreeBlock == NULL )
+		{
+			ulSecondLevelBitmaps[ uxFirstLevel ] &= ~( ( uint32_t ) 1 << uxSecondLevel );
+
+			if( ulSecondLevelBitmaps[ uxFirstLevel ] == 0 )
+			{
+				ulFirstLevelBitmap &= ~( ( uint32_t ) 1 << uxFirstLevel );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void )
+{
+BlockHeader_t *pxFirstFreeBlock;
+uint8_t *pucAlignedHeap;
+size_t uxAddress;
+size_t xTotalHeapSize = configTOTAL_HEAP_SIZE;
+
+	/* Ensure the heap starts on a correctly aligned boundary. */
+	uxAddress = ( size_t ) ucHeap;
+
+	if( ( uxAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+	{
+		uxAddress += ( portBYTE_ALIGNMENT - 1 );
+		uxAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+		xTotalHeapSize -= uxAddress - ( size_t ) ucHeap;
+	}
+
+	pucAlignedHeap = ( uint8_t * ) uxAddress;
+
+	/* pxEnd is used to mark the end of the heap, it is an allocated block that
+	is never freed so no free block is merged past it. */
+	uxAddress = ( ( size_t ) pucAlignedHeap ) + xTotalHeapSize;
+	uxAddress -= xHeapStructSize;
+	uxAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+	pxEnd = ( void * ) uxAddress;
+	pxEnd->xBlockSize = 0;
+
+	/* To start with there is a single free block that is sized to take up the
+	entire heap space, minus the space taken by pxEnd. */
+	pxFirstFreeBlock = ( void * ) pucAlignedHeap;
+	pxFirstFreeBlock->pxPreviousPhysicalBlock = NULL;
+	pxFirstFreeBlock->xBlockSize = uxAddress - ( size_t ) pxFirstFreeBlock;
+	pxEnd->pxPreviousPhysicalBlock = pxFirstFreeBlock;
+
+	xMinimumEverFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+	xFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+
+	prvInsertFreeBlock( pxFirstFreeBlock );
+}
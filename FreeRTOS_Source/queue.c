@@ -403,7 +403,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 			xQueueSizeInBytes = ( size_t ) ( uxQueueLength * uxItemSize ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 		}
 
-		pxNewQueue = ( Queue_t * ) pvPortMalloc( sizeof( Queue_t ) + xQueueSizeInBytes );
+		pxNewQueue = ( Queue_t * ) pvPortMallocWithHint( sizeof( Queue_t ) + xQueueSizeInBytes, portHEAP_HINT_CPU );
 
 		if( pxNewQueue != NULL )
 		{
@@ -153,6 +153,58 @@ a statically allocated stack and a dynamically allocated TCB. */
 	#define static
 #endif
 
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	/* pdTRUE if pxA is to run before pxB when both are ready at
+	configEDF_PRIORITY: pxA has no deadline and pxB has one, or both have one
+	and pxA's is earlier.  Deadlines are compared modulo the tick count. */
+	#define taskRUNS_BEFORE( pxA, pxB )																	\
+		( ( ( pxA )->xHasDeadline == pdFALSE ) ?															\
+			( ( pxB )->xHasDeadline != pdFALSE ) :															\
+			( ( ( pxB )->xHasDeadline != pdFALSE ) &&														\
+			  ( ( TickType_t ) ( ( pxB )->xDeadline - ( pxA )->xDeadline - ( TickType_t ) 1 ) < ( portMAX_DELAY >> 1 ) ) ) )
+
+	/* The tasks of configEDF_PRIORITY are kept in deadline order, the head of
+	their ready list is always the one to run.  Every other priority shares the
+	processor round robin. */
+	#define taskSELECT_FROM_READY_LIST( uxTopPriority )													\
+	{																									\
+		if( ( uxTopPriority ) == ( UBaseType_t ) configEDF_PRIORITY )									\
+		{																								\
+			pxCurrentTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxReadyTasksLists[ ( uxTopPriority ) ] ) );	\
+		}																								\
+		else																							\
+		{																								\
+			listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ ( uxTopPriority ) ] ) );	\
+		}																								\
+	}
+
+	/* pdTRUE if pxTCB, which has just been made ready, is to preempt the
+	currently executing task. */
+	#define taskPREEMPTS_CURRENT( pxTCB )																\
+		( ( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority ) ||											\
+		  ( ( ( pxTCB )->uxPriority == ( UBaseType_t ) configEDF_PRIORITY ) &&								\
+			( pxCurrentTCB->uxPriority == ( UBaseType_t ) configEDF_PRIORITY ) &&							\
+			taskRUNS_BEFORE( ( pxTCB ), pxCurrentTCB ) ) )
+
+	/* Time slicing would only select the head of the deadline ordered list
+	again, so the tasks of configEDF_PRIORITY are not switched on the tick. */
+	#define taskUSES_TIME_SLICING( uxPriority )	( ( uxPriority ) != ( UBaseType_t ) configEDF_PRIORITY )
+
+#else
+
+	/* listGET_OWNER_OF_NEXT_ENTRY indexes through the list, so the tasks of the
+	same priority get an equal share of the processor time. */
+	#define taskSELECT_FROM_READY_LIST( uxTopPriority )	listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ ( uxTopPriority ) ] ) )
+
+	#define taskPREEMPTS_CURRENT( pxTCB )	( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority )
+
+	#define taskUSES_TIME_SLICING( uxPriority )	( pdTRUE )
+
+#endif /* configUSE_EDF_SCHEDULING */
+
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
 
 	/* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
@@ -182,9 +234,7 @@ a statically allocated stack and a dynamically allocated TCB. */
 			--uxTopPriority;																			\
 		}																								\
 																										\
-		/* listGET_OWNER_OF_NEXT_ENTRY indexes through the list, so the tasks of						\
-		the	same priority get an equal share of the processor time. */									\
-		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );			\
+		taskSELECT_FROM_READY_LIST( uxTopPriority );													\
 		uxTopReadyPriority = uxTopPriority;																\
 	} /* taskSELECT_HIGHEST_PRIORITY_TASK */
 
@@ -214,7 +264,7 @@ a statically allocated stack and a dynamically allocated TCB. */
 		/* Find the highest priority list that contains ready tasks. */								\
 		portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );								\
 		configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 );		\
-		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );		\
+		taskSELECT_FROM_READY_LIST( uxTopPriority );												\
 	} /* taskSELECT_HIGHEST_PRIORITY_TASK() */
 
 	/*-----------------------------------------------------------*/
@@ -254,13 +304,29 @@ count overflows. */
 
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
- * the task.  It is inserted at the end of the list.
+ * the task.  It is inserted at the end of the list, or in deadline order if
+ * the task runs at configEDF_PRIORITY.
  */
-#define prvAddTaskToReadyList( pxTCB )																\
-	traceMOVED_TASK_TO_READY_STATE( pxTCB );														\
-	taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );												\
-	vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
-	tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
+#if ( configUSE_EDF_SCHEDULING == 1 )
+	#define prvAddTaskToReadyList( pxTCB )																\
+		traceMOVED_TASK_TO_READY_STATE( pxTCB );														\
+		taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );												\
+		if( ( pxTCB )->uxPriority == ( UBaseType_t ) configEDF_PRIORITY )								\
+		{																								\
+			prvInsertTaskInDeadlineOrder( pxTCB );														\
+		}																								\
+		else																							\
+		{																								\
+			vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+		}																								\
+		tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
+#else
+	#define prvAddTaskToReadyList( pxTCB )																\
+		traceMOVED_TASK_TO_READY_STATE( pxTCB );														\
+		taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );												\
+		vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+		tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
+#endif /* configUSE_EDF_SCHEDULING */
 /*-----------------------------------------------------------*/
 
 /*
@@ -326,6 +392,11 @@ typedef struct tskTaskControlBlock
 		TaskHookFunction_t pxTaskTag;
 	#endif
 
+	#if ( configUSE_EDF_SCHEDULING == 1 )
+		TickType_t		xDeadline;			/*< The absolute deadline set by vTaskSetDeadline(), orders the ready tasks of configEDF_PRIORITY. */
+		BaseType_t		xHasDeadline;		/*< pdFALSE until the first vTaskSetDeadline() call. */
+	#endif
+
 	#if( configNUM_THREAD_LOCAL_STORAGE_POINTERS > 0 )
 		void *pvThreadLocalStoragePointers[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];
 	#endif
@@ -550,6 +621,17 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseT
  */
 static void prvResetNextTaskUnblockTime( void );
 
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	/*
+	 * Insert pxTCB into the ready list of configEDF_PRIORITY behind every task
+	 * that does not run after it (see taskRUNS_BEFORE()), so the list stays in
+	 * deadline order and equal deadlines stay in FIFO order.
+	 */
+	static void prvInsertTaskInDeadlineOrder( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
 #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
 
 	/*
@@ -640,7 +722,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 			/* Allocate space for the TCB.  Where the memory comes from depends
 			on the implementation of the port malloc function and whether or
 			not static allocation is being used. */
-			pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+			pxNewTCB = ( TCB_t * ) pvPortMallocWithHint( sizeof( TCB_t ), portHEAP_HINT_CPU );
 
 			if( pxNewTCB != NULL )
 			{
@@ -691,14 +773,14 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 			/* Allocate space for the TCB.  Where the memory comes from depends on
 			the implementation of the port malloc function and whether or not static
 			allocation is being used. */
-			pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+			pxNewTCB = ( TCB_t * ) pvPortMallocWithHint( sizeof( TCB_t ), portHEAP_HINT_CPU );
 
 			if( pxNewTCB != NULL )
 			{
 				/* Allocate space for the stack used by the task being created.
 				The base of the stack memory stored in the TCB so the task can
 				be deleted later if required. */
-				pxNewTCB->pxStack = ( StackType_t * ) pvPortMalloc( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+				pxNewTCB->pxStack = ( StackType_t * ) pvPortMallocWithHint( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ), portHEAP_HINT_CPU ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
 				if( pxNewTCB->pxStack == NULL )
 				{
@@ -713,12 +795,12 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 		StackType_t *pxStack;
 
 			/* Allocate space for the stack used by the task being created. */
-			pxStack = ( StackType_t * ) pvPortMalloc( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+			pxStack = ( StackType_t * ) pvPortMallocWithHint( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ), portHEAP_HINT_CPU ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
 			if( pxStack != NULL )
 			{
 				/* Allocate space for the TCB. */
-				pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) ); /*lint !e961 MISRA exception as the casts are only redundant for some paths. */
+				pxNewTCB = ( TCB_t * ) pvPortMallocWithHint( sizeof( TCB_t ), portHEAP_HINT_CPU ); /*lint !e961 MISRA exception as the casts are only redundant for some paths. */
 
 				if( pxNewTCB != NULL )
 				{
@@ -887,6 +969,13 @@ UBaseType_t x;
 	}
 	#endif /* configUSE_APPLICATION_TASK_TAG */
 
+	#if ( configUSE_EDF_SCHEDULING == 1 )
+	{
+		pxNewTCB->xDeadline = ( TickType_t ) 0U;
+		pxNewTCB->xHasDeadline = pdFALSE;
+	}
+	#endif /* configUSE_EDF_SCHEDULING */
+
 	#if ( configGENERATE_RUN_TIME_STATS == 1 )
 	{
 		pxNewTCB->ulRunTimeCounter = 0UL;
@@ -1561,6 +1650,74 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 #endif /* INCLUDE_vTaskPrioritySet */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	void vTaskSetDeadline( TaskHandle_t xTask, TickType_t xDeadline )
+	{
+	TCB_t *pxTCB;
+	List_t * const pxDeadlineReadyList = &( pxReadyTasksLists[ configEDF_PRIORITY ] );
+	BaseType_t xYieldRequired = pdFALSE;
+
+		taskENTER_CRITICAL();
+		{
+			/* If null is passed in here then it is the deadline of the calling
+			task that is being changed. */
+			pxTCB = prvGetTCBFromHandle( xTask );
+
+			pxTCB->xDeadline = xDeadline;
+			pxTCB->xHasDeadline = pdTRUE;
+
+			/* A task that is blocked, suspended or of another priority only
+			needs the new value, it is put in order when it next enters the
+			deadline ordered ready list. */
+			if( listIS_CONTAINED_WITHIN( pxDeadlineReadyList, &( pxTCB->xStateListItem ) ) != pdFALSE )
+			{
+				/* The task is re-inserted straight away, so its priority stays
+				recorded as ready even if the list is empty in between. */
+				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+				prvInsertTaskInDeadlineOrder( pxTCB );
+
+				if( pxTCB == pxCurrentTCB )
+				{
+					/* The running task may no longer be the earliest. */
+					if( listGET_OWNER_OF_HEAD_ENTRY( pxDeadlineReadyList ) != pxCurrentTCB )
+					{
+						xYieldRequired = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else if( taskPREEMPTS_CURRENT( pxTCB ) )
+				{
+					xYieldRequired = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				if( xYieldRequired != pdFALSE )
+				{
+					taskYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
 #if ( INCLUDE_vTaskSuspend == 1 )
 
 	void vTaskSuspend( TaskHandle_t xTaskToSuspend )
@@ -2470,7 +2627,7 @@ implementations require configUSE_TICKLESS_IDLE to be set to a value other than
 					/* Preemption is on, but a context switch should only be
 					performed if the unblocked task has a priority that is
 					equal to or higher than the currently executing task. */
-					if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+					if( taskPREEMPTS_CURRENT( pxTCB ) )
 					{
 						/* Pend the yield to be performed when the scheduler
 						is unsuspended. */
@@ -2612,7 +2769,7 @@ BaseType_t xSwitchRequired = pdFALSE;
 		writer has not explicitly turned time slicing off. */
 		#if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
 		{
-			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+			if( ( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 ) && taskUSES_TIME_SLICING( pxCurrentTCB->uxPriority ) )
 			{
 				xSwitchRequired = pdTRUE;
 			}
@@ -2925,7 +3082,7 @@ BaseType_t xReturn;
 		vListInsertEnd( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
 	}
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	if( taskPREEMPTS_CURRENT( pxUnblockedTCB ) )
 	{
 		/* Return true if the task removed from the event list has a higher
 		priority than the calling task.  This allows the calling task to know if
@@ -2983,7 +3140,7 @@ BaseType_t xReturn;
 	( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
 	prvAddTaskToReadyList( pxUnblockedTCB );
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	if( taskPREEMPTS_CURRENT( pxUnblockedTCB ) )
 	{
 		/* Return true if the task removed from the event list has
 		a higher priority than the calling task.  This allows
@@ -3632,6 +3789,39 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* INCLUDE_vTaskDelete */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	static void prvInsertTaskInDeadlineOrder( TCB_t * const pxTCB )
+	{
+	List_t * const pxList = &( pxReadyTasksLists[ configEDF_PRIORITY ] );
+	ListItem_t * const pxNewListItem = &( pxTCB->xStateListItem );
+	ListItem_t *pxIterator;
+
+		/* Walk back from the end marker while the task runs before the task
+		in front of it.  A task is most often made ready with the latest
+		deadline so far, this stops at the first comparison. */
+		for( pxIterator = ( ListItem_t * ) &( pxList->xListEnd ); pxIterator->pxPrevious != ( ListItem_t * ) &( pxList->xListEnd ); pxIterator = pxIterator->pxPrevious ) /*lint !e826 !e740 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+		{
+			if( taskRUNS_BEFORE( pxTCB, ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator->pxPrevious ) ) == pdFALSE )
+			{
+				break;
+			}
+		}
+
+		/* Insert in front of pxIterator, as vListInsertEnd() does in front of
+		the index. */
+		pxNewListItem->pxNext = pxIterator;
+		pxNewListItem->pxPrevious = pxIterator->pxPrevious;
+		pxIterator->pxPrevious->pxNext = pxNewListItem;
+		pxIterator->pxPrevious = pxNewListItem;
+		pxNewListItem->pvContainer = ( void * ) pxList;
+
+		( pxList->uxNumberOfItems )++;
+	}
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
 static void prvResetNextTaskUnblockTime( void )
 {
 TCB_t *pxTCB;
@@ -4420,7 +4610,7 @@ TickType_t uxReturn;
 				}
 				#endif
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskPREEMPTS_CURRENT( pxTCB ) )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -4538,7 +4728,7 @@ TickType_t uxReturn;
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskPREEMPTS_CURRENT( pxTCB ) )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -4628,7 +4818,7 @@ TickType_t uxReturn;
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskPREEMPTS_CURRENT( pxTCB ) )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
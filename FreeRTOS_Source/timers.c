@@ -100,6 +100,27 @@ configUSE_TIMERS is set to 1 in FreeRTOSConfig.h. */
 /* Misc definitions. */
 #define tmrNO_DELAY		( TickType_t ) 0U
 
+#if ( configUSE_TIMER_WHEEL == 1 )
+	/* Geometry of the timing wheel.  Level n has tmrWHEEL_SLOTS slots of
+	tmrWHEEL_SLOTS^n ticks each, so the levels together cover
+	2^( tmrWHEEL_SLOT_BITS * tmrWHEEL_LEVELS ) ticks ahead of the wheel time.
+	Timers further away wait in the far list. */
+	#define tmrWHEEL_SLOT_BITS		( 5U )
+	#define tmrWHEEL_SLOTS			( 1U << tmrWHEEL_SLOT_BITS )
+	#define tmrWHEEL_SLOT_MASK		( ( TickType_t ) ( tmrWHEEL_SLOTS - 1U ) )
+	#define tmrWHEEL_LEVELS			( 4U )
+	#define tmrWHEEL_SPAN_BITS		( tmrWHEEL_SLOT_BITS * tmrWHEEL_LEVELS )
+
+	#if ( tmrWHEEL_SLOTS > 32U ) || ( tmrWHEEL_SPAN_BITS >= 32U )
+		#error The timer wheel occupancy is kept in 32-bit masks and must span less than the tick range.
+	#endif
+
+	/* Index of the lowest set bit of a non-zero occupancy mask. */
+	#ifndef tmrWHEEL_LOWEST_SET_BIT
+		#define tmrWHEEL_LOWEST_SET_BIT( ulMask )	( ( UBaseType_t ) __builtin_ctz( ulMask ) )
+	#endif
+#endif /* configUSE_TIMER_WHEEL */
+
 /* The definition of the timers themselves. */
 typedef struct tmrTimerControl
 {
@@ -161,13 +182,36 @@ typedef struct tmrTimerQueueMessage
 /*lint -e956 A manual analysis and inspection has been used to determine which
 static variables must be declared volatile. */
 
-/* The list in which active timers are stored.  Timers are referenced in expire
-time order, with the nearest expiry time at the front of the list.  Only the
-timer service task is allowed to access these lists. */
-PRIVILEGED_DATA static List_t xActiveTimerList1;
-PRIVILEGED_DATA static List_t xActiveTimerList2;
-PRIVILEGED_DATA static List_t *pxCurrentTimerList;
-PRIVILEGED_DATA static List_t *pxOverflowTimerList;
+#if ( configUSE_TIMER_WHEEL == 0 )
+
+	/* The list in which active timers are stored.  Timers are referenced in expire
+	time order, with the nearest expiry time at the front of the list.  Only the
+	timer service task is allowed to access these lists. */
+	PRIVILEGED_DATA static List_t xActiveTimerList1;
+	PRIVILEGED_DATA static List_t xActiveTimerList2;
+	PRIVILEGED_DATA static List_t *pxCurrentTimerList;
+	PRIVILEGED_DATA static List_t *pxOverflowTimerList;
+
+#else
+
+	/* Hierarchical timing wheel in which active timers are stored.  A timer
+	sits in the lowest level whose slot holds its expiry time: level n is used
+	when the expiry time and xTimerWheelTime only differ in the bits of the
+	level n slot index or below, and the slot is the level n digit of the
+	expiry time.  Slots are unsorted lists, so starting and stopping a timer is
+	O(1).  When the wheel time reaches the start of a higher level slot that
+	slot is cascaded into the levels below.  ulTimerWheelOccupied has one bit
+	per non-empty slot, so the next slot to expire or cascade is found without
+	scanning.  Only the timer service task is allowed to access the wheel. */
+	PRIVILEGED_DATA static List_t xTimerWheel[ tmrWHEEL_LEVELS ][ tmrWHEEL_SLOTS ];
+	PRIVILEGED_DATA static List_t xTimerWheelFarList;
+	PRIVILEGED_DATA static uint32_t ulTimerWheelOccupied[ tmrWHEEL_LEVELS ];
+	PRIVILEGED_DATA static UBaseType_t uxTimersInWheel = ( UBaseType_t ) 0U;
+
+	/* Every slot before this time has been expired or cascaded. */
+	PRIVILEGED_DATA static TickType_t xTimerWheelTime = ( TickType_t ) 0U;
+
+#endif /* configUSE_TIMER_WHEEL */
 
 /* A queue that is used to send commands to the timer service task. */
 PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
@@ -214,15 +258,49 @@ static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer, const Tic
 
 /*
  * An active timer has reached its expire time.  Reload the timer if it is an
- * auto reload timer, then call its callback.
+ * auto reload timer, then call its callback.  With configUSE_TIMER_WHEEL every
+ * timer that expired up to xTimeNow is processed.
  */
 static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
 
 /*
- * The tick count has overflowed.  Switch the timer lists after ensuring the
- * current timer list does not still reference some timers.
+ * Reload pxTimer if it is an auto reload timer that expired at xExpiredTime,
+ * then call its callback.  The timer has already been removed from the active
+ * timers.
  */
-static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
+static void prvReloadAndCallTimer( Timer_t * const pxTimer, const TickType_t xExpiredTime, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_TIMER_WHEEL == 0 )
+
+	/*
+	 * The tick count has overflowed.  Switch the timer lists after ensuring the
+	 * current timer list does not still reference some timers.
+	 */
+	static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
+
+#else
+
+	/*
+	 * Add a timer to, or remove it from, the slot of the timing wheel that
+	 * holds its expiry time.  Both are O(1).
+	 */
+	static void prvWheelInsert( Timer_t * const pxTimer, const TickType_t xExpiryTime ) PRIVILEGED_FUNCTION;
+	static void prvWheelRemove( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Return the first time at which a level 0 slot expires or a higher level
+	 * slot, or the far list, has to be cascaded, and set *pxWheelWasEmpty to
+	 * pdFALSE.  If the wheel holds no timers return 0 and set *pxWheelWasEmpty
+	 * to pdTRUE.
+	 */
+	static TickType_t prvWheelGetNextEventTime( BaseType_t * const pxWheelWasEmpty ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Re-insert every timer of pxList relative to the current wheel time.
+	 */
+	static void prvWheelCascade( List_t * const pxList ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMER_WHEEL */
 
 /*
  * Obtain the current tick count, setting *pxTimerListsWereSwitched to pdTRUE
@@ -319,7 +397,7 @@ BaseType_t xReturn = pdFAIL;
 	{
 	Timer_t *pxNewTimer;
 
-		pxNewTimer = ( Timer_t * ) pvPortMalloc( sizeof( Timer_t ) );
+		pxNewTimer = ( Timer_t * ) pvPortMallocWithHint( sizeof( Timer_t ), portHEAP_HINT_CPU );
 
 		if( pxNewTimer != NULL )
 		{
@@ -495,14 +573,76 @@ Timer_t *pxTimer = ( Timer_t * ) xTimer;
 }
 /*-----------------------------------------------------------*/
 
-static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow )
+#if ( configUSE_TIMER_WHEEL == 0 )
+
+	static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow )
+	{
+	Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
+
+		/* Remove the timer from the list of active timers.  A check has already
+		been performed to ensure the list is not empty. */
+		( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+		prvReloadAndCallTimer( pxTimer, xNextExpireTime, xTimeNow );
+	}
+
+#else
+
+	static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow )
+	{
+	TickType_t xEventTime = xNextExpireTime;
+	BaseType_t xWheelWasEmpty = pdFALSE;
+	UBaseType_t uxLevel;
+	List_t *pxSlot;
+	Timer_t *pxTimer;
+
+		/* Visit the wheel events up to xTimeNow in time order.  At each one
+		first cascade every slot that starts there, top level first, then
+		expire the level 0 slot of that tick.  Auto reload timers are
+		re-inserted after the event, so they are picked up by a later one. */
+		while( ( xWheelWasEmpty == pdFALSE ) && ( ( int32_t ) ( xTimeNow - xEventTime ) >= 0 ) )
+		{
+			xTimerWheelTime = xEventTime;
+
+			if( ( xEventTime & ( ( ( TickType_t ) 1U << tmrWHEEL_SPAN_BITS ) - 1U ) ) == ( TickType_t ) 0U )
+			{
+				prvWheelCascade( &xTimerWheelFarList );
+			}
+
+			for( uxLevel = tmrWHEEL_LEVELS - 1U; uxLevel > 0U; uxLevel-- )
+			{
+				if( ( xEventTime & ( ( ( TickType_t ) 1U << ( uxLevel * tmrWHEEL_SLOT_BITS ) ) - 1U ) ) == ( TickType_t ) 0U )
+				{
+					prvWheelCascade( &( xTimerWheel[ uxLevel ][ ( xEventTime >> ( uxLevel * tmrWHEEL_SLOT_BITS ) ) & tmrWHEEL_SLOT_MASK ] ) );
+				}
+			}
+
+			pxSlot = &( xTimerWheel[ 0 ][ xEventTime & tmrWHEEL_SLOT_MASK ] );
+
+			while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+			{
+				pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot );
+				prvWheelRemove( pxTimer );
+				prvReloadAndCallTimer( pxTimer, xEventTime, xTimeNow );
+			}
+
+			xEventTime = prvWheelGetNextEventTime( &xWheelWasEmpty );
+		}
+
+		/* Nothing else happens before xTimeNow, so the wheel can skip there and
+		place the timers started from now on in the finest slots. */
+		if( ( int32_t ) ( xTimeNow - xTimerWheelTime ) > 0 )
+		{
+			xTimerWheelTime = xTimeNow;
+		}
+	}
+
+#endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+static void prvReloadAndCallTimer( Timer_t * const pxTimer, const TickType_t xExpiredTime, const TickType_t xTimeNow )
 {
 BaseType_t xResult;
-Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
 
-	/* Remove the timer from the list of active timers.  A check has already
-	been performed to ensure the list is not empty. */
-	( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
 	traceTIMER_EXPIRED( pxTimer );
 
 	/* If the timer is an auto reload timer then calculate the next
@@ -512,11 +652,11 @@ Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTi
 		/* The timer is inserted into a list using a time relative to anything
 		other than the current time.  It will therefore be inserted into the
 		correct list relative to the time this task thinks it is now. */
-		if( prvInsertTimerInActiveList( pxTimer, ( xNextExpireTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xNextExpireTime ) != pdFALSE )
+		if( prvInsertTimerInActiveList( pxTimer, ( xExpiredTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xExpiredTime ) != pdFALSE )
 		{
 			/* The timer expired before it was added to the active timer
 			list.  Reload it now.  */
-			xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xNextExpireTime, NULL, tmrNO_DELAY );
+			xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xExpiredTime, NULL, tmrNO_DELAY );
 			configASSERT( xResult );
 			( void ) xResult;
 		}
@@ -574,7 +714,7 @@ BaseType_t xListWasEmpty;
 static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime, BaseType_t xListWasEmpty )
 {
 TickType_t xTimeNow;
-BaseType_t xTimerListsWereSwitched;
+BaseType_t xTimerListsWereSwitched, xTimerHasExpired;
 
 	vTaskSuspendAll();
 	{
@@ -586,8 +726,16 @@ BaseType_t xTimerListsWereSwitched;
 		xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
 		if( xTimerListsWereSwitched == pdFALSE )
 		{
-			/* The tick count has not overflowed, has the timer expired? */
-			if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) )
+			/* The tick count has not overflowed, has the timer expired?  Wheel
+			event times wrap with the tick count, so they are compared as a
+			signed difference. */
+			#if ( configUSE_TIMER_WHEEL == 0 )
+				xTimerHasExpired = ( xNextExpireTime <= xTimeNow );
+			#else
+				xTimerHasExpired = ( ( int32_t ) ( xTimeNow - xNextExpireTime ) >= 0 );
+			#endif
+
+			if( ( xListWasEmpty == pdFALSE ) && ( xTimerHasExpired != pdFALSE ) )
 			{
 				( void ) xTaskResumeAll();
 				prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
@@ -600,12 +748,16 @@ BaseType_t xTimerListsWereSwitched;
 				received - whichever comes first.  The following line cannot
 				be reached unless xNextExpireTime > xTimeNow, except in the
 				case when the current timer list is empty. */
-				if( xListWasEmpty != pdFALSE )
+				#if ( configUSE_TIMER_WHEEL == 0 )
 				{
-					/* The current timer list is empty - is the overflow list
-					also empty? */
-					xListWasEmpty = listLIST_IS_EMPTY( pxOverflowTimerList );
+					if( xListWasEmpty != pdFALSE )
+					{
+						/* The current timer list is empty - is the overflow list
+						also empty? */
+						xListWasEmpty = listLIST_IS_EMPTY( pxOverflowTimerList );
+					}
 				}
+				#endif /* configUSE_TIMER_WHEEL */
 
 				vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
 
@@ -635,23 +787,33 @@ static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty )
 {
 TickType_t xNextExpireTime;
 
-	/* Timers are listed in expiry time order, with the head of the list
-	referencing the task that will expire first.  Obtain the time at which
-	the timer with the nearest expiry time will expire.  If there are no
-	active timers then just set the next expire time to 0.  That will cause
-	this task to unblock when the tick count overflows, at which point the
-	timer lists will be switched and the next expiry time can be
-	re-assessed.  */
-	*pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
-	if( *pxListWasEmpty == pdFALSE )
+	#if ( configUSE_TIMER_WHEEL == 0 )
 	{
-		xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+		/* Timers are listed in expiry time order, with the head of the list
+		referencing the task that will expire first.  Obtain the time at which
+		the timer with the nearest expiry time will expire.  If there are no
+		active timers then just set the next expire time to 0.  That will cause
+		this task to unblock when the tick count overflows, at which point the
+		timer lists will be switched and the next expiry time can be
+		re-assessed.  */
+		*pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
+		if( *pxListWasEmpty == pdFALSE )
+		{
+			xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+		}
+		else
+		{
+			/* Ensure the task unblocks when the tick count rolls over. */
+			xNextExpireTime = ( TickType_t ) 0U;
+		}
 	}
-	else
+	#else
 	{
-		/* Ensure the task unblocks when the tick count rolls over. */
-		xNextExpireTime = ( TickType_t ) 0U;
+		/* The tick count wraps inside the wheel, there is no overflow list to
+		wait for.  An empty wheel blocks until the next command. */
+		xNextExpireTime = prvWheelGetNextEventTime( pxListWasEmpty );
 	}
+	#endif /* configUSE_TIMER_WHEEL */
 
 	return xNextExpireTime;
 }
@@ -660,21 +822,31 @@ TickType_t xNextExpireTime;
 static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched )
 {
 TickType_t xTimeNow;
-PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U; /*lint !e956 Variable is only accessible to one task. */
 
 	xTimeNow = xTaskGetTickCount();
 
-	if( xTimeNow < xLastTime )
+	#if ( configUSE_TIMER_WHEEL == 0 )
 	{
-		prvSwitchTimerLists();
-		*pxTimerListsWereSwitched = pdTRUE;
+	PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U; /*lint !e956 Variable is only accessible to one task. */
+
+		if( xTimeNow < xLastTime )
+		{
+			prvSwitchTimerLists();
+			*pxTimerListsWereSwitched = pdTRUE;
+		}
+		else
+		{
+			*pxTimerListsWereSwitched = pdFALSE;
+		}
+
+		xLastTime = xTimeNow;
 	}
-	else
+	#else
 	{
+		/* Only the overflow lists need the previous sample. */
 		*pxTimerListsWereSwitched = pdFALSE;
 	}
-
-	xLastTime = xTimeNow;
+	#endif /* configUSE_TIMER_WHEEL */
 
 	return xTimeNow;
 }
@@ -687,6 +859,17 @@ BaseType_t xProcessTimerNow = pdFALSE;
 	listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
 	listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
 
+	#if ( configUSE_TIMER_WHEEL == 1 )
+	{
+		/* An empty wheel has no slot left to expire, restart it at the current
+		time so the timer goes to the finest level possible. */
+		if( uxTimersInWheel == ( UBaseType_t ) 0U )
+		{
+			xTimerWheelTime = xTimeNow;
+		}
+	}
+	#endif /* configUSE_TIMER_WHEEL */
+
 	if( xNextExpiryTime <= xTimeNow )
 	{
 		/* Has the expiry time elapsed between the command to start/reset a
@@ -699,7 +882,11 @@ BaseType_t xProcessTimerNow = pdFALSE;
 		}
 		else
 		{
-			vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+			#if ( configUSE_TIMER_WHEEL == 0 )
+				vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+			#else
+				prvWheelInsert( pxTimer, xNextExpiryTime );
+			#endif
 		}
 	}
 	else
@@ -713,7 +900,11 @@ BaseType_t xProcessTimerNow = pdFALSE;
 		}
 		else
 		{
-			vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+			#if ( configUSE_TIMER_WHEEL == 0 )
+				vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+			#else
+				prvWheelInsert( pxTimer, xNextExpiryTime );
+			#endif
 		}
 	}
 
@@ -763,7 +954,11 @@ TickType_t xTimeNow;
 			if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE )
 			{
 				/* The timer is in a list, remove it. */
-				( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+				#if ( configUSE_TIMER_WHEEL == 0 )
+					( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+				#else
+					prvWheelRemove( pxTimer );
+				#endif
 			}
 			else
 			{
@@ -868,6 +1063,8 @@ TickType_t xTimeNow;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TIMER_WHEEL == 0 )
+
 static void prvSwitchTimerLists( void )
 {
 TickType_t xNextExpireTime, xReloadTime;
@@ -925,6 +1122,105 @@ BaseType_t xResult;
 	pxCurrentTimerList = pxOverflowTimerList;
 	pxOverflowTimerList = pxTemp;
 }
+
+#else
+
+static void prvWheelInsert( Timer_t * const pxTimer, const TickType_t xExpiryTime )
+{
+const TickType_t xDifferentBits = xExpiryTime ^ xTimerWheelTime;
+UBaseType_t uxLevel;
+UBaseType_t uxSlot;
+
+	uxTimersInWheel++;
+
+	for( uxLevel = 0U; uxLevel < tmrWHEEL_LEVELS; uxLevel++ )
+	{
+		if( ( xDifferentBits >> ( ( uxLevel + 1U ) * tmrWHEEL_SLOT_BITS ) ) == ( TickType_t ) 0U )
+		{
+			uxSlot = ( UBaseType_t ) ( ( xExpiryTime >> ( uxLevel * tmrWHEEL_SLOT_BITS ) ) & tmrWHEEL_SLOT_MASK );
+			vListInsertEnd( &( xTimerWheel[ uxLevel ][ uxSlot ] ), &( pxTimer->xTimerListItem ) );
+			ulTimerWheelOccupied[ uxLevel ] |= ( 1UL << uxSlot );
+			return;
+		}
+	}
+
+	vListInsertEnd( &xTimerWheelFarList, &( pxTimer->xTimerListItem ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWheelRemove( Timer_t * const pxTimer )
+{
+List_t * const pxList = ( List_t * ) listLIST_ITEM_CONTAINER( &( pxTimer->xTimerListItem ) );
+UBaseType_t uxIndex;
+
+	uxTimersInWheel--;
+
+	if( ( uxListRemove( &( pxTimer->xTimerListItem ) ) == ( UBaseType_t ) 0U ) && ( pxList != &xTimerWheelFarList ) )
+	{
+		uxIndex = ( UBaseType_t ) ( pxList - &( xTimerWheel[ 0 ][ 0 ] ) );
+		ulTimerWheelOccupied[ uxIndex / tmrWHEEL_SLOTS ] &= ~( 1UL << ( uxIndex % tmrWHEEL_SLOTS ) );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static TickType_t prvWheelGetNextEventTime( BaseType_t * const pxWheelWasEmpty )
+{
+UBaseType_t uxLevel;
+UBaseType_t uxShift;
+UBaseType_t uxIndex;
+uint32_t ulPending;
+
+	if( uxTimersInWheel == ( UBaseType_t ) 0U )
+	{
+		*pxWheelWasEmpty = pdTRUE;
+		return ( TickType_t ) 0U;
+	}
+
+	*pxWheelWasEmpty = pdFALSE;
+
+	/* A level 0 slot is due at its own tick, from the current one on.  A higher
+	level slot after the current one is cascaded where it starts.  The first
+	level with a pending slot holds the earliest event, every slot of a higher
+	level starts after the current slot of the level below has ended. */
+	for( uxLevel = 0U; uxLevel < tmrWHEEL_LEVELS; uxLevel++ )
+	{
+		uxShift = uxLevel * tmrWHEEL_SLOT_BITS;
+		uxIndex = ( UBaseType_t ) ( ( xTimerWheelTime >> uxShift ) & tmrWHEEL_SLOT_MASK );
+		ulPending = ulTimerWheelOccupied[ uxLevel ] & ( ( 0xFFFFFFFFUL << uxIndex ) << ( ( uxLevel == 0U ) ? 0U : 1U ) );
+
+		if( ulPending != 0UL )
+		{
+			return ( ( xTimerWheelTime >> ( uxShift + tmrWHEEL_SLOT_BITS ) ) << ( uxShift + tmrWHEEL_SLOT_BITS ) ) |
+				( ( TickType_t ) tmrWHEEL_LOWEST_SET_BIT( ulPending ) << uxShift );
+		}
+	}
+
+	/* Only far timers are left, they are cascaded where the top level wraps. */
+	return ( ( xTimerWheelTime >> tmrWHEEL_SPAN_BITS ) + 1U ) << tmrWHEEL_SPAN_BITS;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWheelCascade( List_t * const pxList )
+{
+UBaseType_t uxRemaining = listCURRENT_LIST_LENGTH( pxList );
+Timer_t *pxTimer;
+
+	/* Far timers that are still out of range go back to the end of the far
+	list, so only the timers present on entry are moved. */
+	while( uxRemaining > ( UBaseType_t ) 0U )
+	{
+		pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxList );
+		prvWheelRemove( pxTimer );
+		prvWheelInsert( pxTimer, listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) ) );
+		uxRemaining--;
+	}
+}
+
+#endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
 static void prvCheckForValidListAndQueue( void )
@@ -936,10 +1232,28 @@ static void prvCheckForValidListAndQueue( void )
 	{
 		if( xTimerQueue == NULL )
 		{
-			vListInitialise( &xActiveTimerList1 );
-			vListInitialise( &xActiveTimerList2 );
-			pxCurrentTimerList = &xActiveTimerList1;
-			pxOverflowTimerList = &xActiveTimerList2;
+			#if ( configUSE_TIMER_WHEEL == 0 )
+			{
+				vListInitialise( &xActiveTimerList1 );
+				vListInitialise( &xActiveTimerList2 );
+				pxCurrentTimerList = &xActiveTimerList1;
+				pxOverflowTimerList = &xActiveTimerList2;
+			}
+			#else
+			{
+			UBaseType_t uxLevel, uxSlot;
+
+				for( uxLevel = 0U; uxLevel < tmrWHEEL_LEVELS; uxLevel++ )
+				{
+					for( uxSlot = 0U; uxSlot < tmrWHEEL_SLOTS; uxSlot++ )
+					{
+						vListInitialise( &( xTimerWheel[ uxLevel ][ uxSlot ] ) );
+					}
+				}
+
+				vListInitialise( &xTimerWheelFarList );
+			}
+			#endif /* configUSE_TIMER_WHEEL */
 
 			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
 			{
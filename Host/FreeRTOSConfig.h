@@ -0,0 +1,35 @@
+/*
+ * Host (POSIX) overrides on top of the target configuration in
+ * src/FreeRTOSConfig.h.  This directory is first on the host include path so
+ * the kernel and src/main.c pick up this file, which pulls in the target
+ * settings and only replaces what cannot hold on a 64-bit Linux process.
+ */
+
+#ifndef HOST_FREERTOS_CONFIG_H
+#define HOST_FREERTOS_CONFIG_H
+
+#include <stdint.h>
+#include "../src/FreeRTOSConfig.h"
+
+/* Stack words are twice as wide on the 64-bit host and every task also needs
+room for its thread state. */
+#undef configTOTAL_HEAP_SIZE
+#define configTOTAL_HEAP_SIZE			( ( size_t ) ( 256 * 1024 ) )
+
+/* The POSIX port drives its tick from a host interval timer and cannot stop
+it, there is no vPortSuppressTicksAndSleep(). Tickless idle is modelled by
+Host/dds_sim.c instead. A test that stops the interval timer and raises the
+tick itself builds with hostUSE_TICKLESS_IDLE=1 and steps the tick count in its
+own dd_suppress_ticks_and_sleep(), see Host/dds_wheel.c. */
+#ifndef hostUSE_TICKLESS_IDLE
+	#define hostUSE_TICKLESS_IDLE		0
+#endif
+#undef configUSE_TICKLESS_IDLE
+#define configUSE_TICKLESS_IDLE			hostUSE_TICKLESS_IDLE
+
+/* A failed assert should stop the process, not spin one of its threads. */
+#undef configASSERT
+#include <assert.h>
+#define configASSERT( x ) assert( x )
+
+#endif /* HOST_FREERTOS_CONFIG_H */
@@ -0,0 +1,89 @@
+/**
+  ******************************************************************************
+  * @file    bench.c
+  * @brief   Fixture shared by the host benchmarks and tests, see bench.h.
+  ******************************************************************************
+  */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "bench.h"
+
+uint64_t bench_now_ns(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+// xorshift64*, pstate must not be 0
+uint32_t bench_random_next(uint64_t *pstate)
+{
+	*pstate ^= *pstate >> 12;
+	*pstate ^= *pstate << 25;
+	*pstate ^= *pstate >> 27;
+
+	return (uint32_t)((*pstate * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+void bench_add_sample(bench_samples_t *psamples, uint64_t ns)
+{
+	if(psamples->count < psamples->max_count)
+	{
+		psamples->pns[psamples->count++] = (uint32_t)ns;
+		psamples->total += ns;
+	}
+}
+
+static int compare_samples(const void *pfirst, const void *psecond)
+{
+	uint32_t first = *(const uint32_t *)pfirst;
+	uint32_t second = *(const uint32_t *)psecond;
+
+	return (first < second) ? -1 : ((first > second) ? 1 : 0);
+}
+
+void bench_sort_samples(bench_samples_t *psamples)
+{
+	qsort(psamples->pns, psamples->count, sizeof(uint32_t), compare_samples);
+}
+
+uint32_t bench_sample_percentile(bench_samples_t *psamples, uint32_t percentile)
+{
+	uint32_t index;
+
+	if(psamples->count == 0)
+	{
+		return 0;
+	}
+
+	index = (uint32_t)(((uint64_t)psamples->count * percentile) / 100);
+
+	return psamples->pns[(index < psamples->count) ? index : (psamples->count - 1)];
+}
+
+double bench_sample_mean(bench_samples_t *psamples)
+{
+	return (psamples->count == 0) ? 0.0 : ((double)psamples->total / (double)psamples->count);
+}
+
+void bench_report_samples(const char *plabel, const char *pname, const char *punit, bench_samples_t *psamples)
+{
+	if(psamples->count == 0)
+	{
+		printf("%s: %-12s no samples\n", plabel, pname);
+		return;
+	}
+
+	bench_sort_samples(psamples);
+	printf("%s: %-12s %7u %s, mean %6.0f ns, p99 %6u ns, max %7u ns\n", plabel, pname, psamples->count, punit,
+		bench_sample_mean(psamples), bench_sample_percentile(psamples, 99), bench_sample_percentile(psamples, 100));
+
+	psamples->count = 0;
+	psamples->total = 0;
+}
@@ -0,0 +1,39 @@
+/**
+  ******************************************************************************
+  * @file    bench.h
+  * @brief   Fixture shared by the host benchmarks and tests: the wall clock,
+  *          latency samples over caller-owned storage and their report, and
+  *          the xorshift64* generator. Host/bench_hooks.c has the kernel
+  *          hooks that src/main.c provides in the DDS build.
+  ******************************************************************************
+  */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+
+// Seed of the generator, so every run draws the same sequence
+#define benchRANDOM_SEED					0x9E3779B97F4A7C15ULL
+
+typedef struct bench_samples
+{
+	uint32_t *pns;						// max_count samples in ns
+	uint32_t max_count;
+	uint32_t count;
+	uint64_t total;
+} bench_samples_t;
+
+uint64_t bench_now_ns(void);
+uint32_t bench_random_next(uint64_t *pstate);
+
+// Samples beyond max_count are dropped
+void bench_add_sample(bench_samples_t *psamples, uint64_t ns);
+void bench_sort_samples(bench_samples_t *psamples);
+// Of sorted samples, percentile 50 is the median and 100 the maximum
+uint32_t bench_sample_percentile(bench_samples_t *psamples, uint32_t percentile);
+double bench_sample_mean(bench_samples_t *psamples);
+// Prints the count, mean, p99 and maximum of the samples and empties them
+void bench_report_samples(const char *plabel, const char *pname, const char *punit, bench_samples_t *psamples);
+
+#endif /* BENCH_H */
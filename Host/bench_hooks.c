@@ -0,0 +1,70 @@
+/**
+  ******************************************************************************
+  * @file    bench_hooks.c
+  * @brief   Kernel hooks that src/main.c provides in the DDS build, for the
+  *          host benchmarks and tests that link the kernel without it.
+  *
+  *          Every hook is weak, a benchmark defines its own where it needs
+  *          to, e.g. to count failed allocations rather than stop.
+  ******************************************************************************
+  */
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+__attribute__((weak)) void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize)
+{
+	static StaticTask_t idle_task_tcb;
+	static StackType_t idle_task_stack[configMINIMAL_STACK_SIZE];
+
+	*ppxIdleTaskTCBBuffer = &idle_task_tcb;
+	*ppxIdleTaskStackBuffer = idle_task_stack;
+	*pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+
+__attribute__((weak)) void vApplicationGetTimerTaskMemory(StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize)
+{
+	static StaticTask_t timer_task_tcb;
+	static StackType_t timer_task_stack[configTIMER_TASK_STACK_DEPTH];
+
+	*ppxTimerTaskTCBBuffer = &timer_task_tcb;
+	*ppxTimerTaskStackBuffer = timer_task_stack;
+	*pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+
+__attribute__((weak)) void dd_task_switched_in(void *ptask_tag, uint32_t task_number)
+{
+	(void) ptask_tag;
+	(void) task_number;
+}
+
+__attribute__((weak)) void dd_task_switched_out(void *ptask_tag, uint32_t task_number)
+{
+	(void) ptask_tag;
+	(void) task_number;
+}
+
+__attribute__((weak)) void vApplicationMallocFailedHook(void)
+{
+	fprintf(stderr, "%s: FreeRTOS heap exhausted\n", program_invocation_short_name);
+	exit(1);
+}
+
+__attribute__((weak)) void vApplicationStackOverflowHook(TaskHandle_t pxTask, char *pcTaskName)
+{
+	(void) pxTask;
+
+	fprintf(stderr, "%s: stack overflow in %s\n", program_invocation_short_name, pcTaskName);
+	exit(1);
+}
+
+__attribute__((weak)) void vApplicationIdleHook(void)
+{
+}
@@ -0,0 +1,38 @@
+/**
+  ******************************************************************************
+  * @file    dd_cycles.c
+  * @brief   Host (POSIX) replacement for src/dd_cycles.c.
+  *
+  *          There is no DWT on the host, a "cycle" is one nanosecond of
+  *          CLOCK_MONOTONIC. It is 64 bits wide already and safe to read
+  *          from the kernel trace hooks, which may run in a signal handler.
+  ******************************************************************************
+  */
+
+#include <stdint.h>
+#include <time.h>
+
+#include "dd_cycles.h"
+
+void dd_cycle_counter_init(void)
+{
+}
+
+uint64_t ullDd_cycle_count(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+uint32_t ulDd_cycles_to_us(uint64_t cycles)
+{
+	return (uint32_t)(cycles / 1000ULL);
+}
+
+uint32_t ulDd_cycles_per_us(void)
+{
+	return 1000;
+}
@@ -0,0 +1,54 @@
+/**
+  ******************************************************************************
+  * @file    dd_memory.c
+  * @brief   Host (POSIX) replacement for src/dd_memory.c.
+  *
+  *          There is no CCM on the host, an array flagged as a CPU only heap
+  *          region stands in for it, so the kernel places its objects the way
+  *          it does on the board.
+  ******************************************************************************
+  */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+
+#include "dd_memory.h"
+
+#if ( configUSE_HEAP_HINTS == 1 )
+
+// The 64 KB of CCM, doubled like the stacks on the 64-bit host
+#define hostCCM_HEAP_SIZE					( 128 * 1024 )
+
+static uint8_t ccm_heap[hostCCM_HEAP_SIZE];
+static uint8_t sram_heap[configTOTAL_HEAP_SIZE];
+
+void dd_memory_init(void)
+{
+	HeapRegion_t heap_regions[3] =
+	{
+		{ ccm_heap, sizeof(ccm_heap), pdTRUE },
+		{ sram_heap, sizeof(sram_heap), pdFALSE },
+		{ NULL, 0, pdFALSE }
+	};
+	HeapRegion_t swap;
+
+	// heap_5 takes the regions in address order, which the linker picks here
+	if(heap_regions[0].pucStartAddress > heap_regions[1].pucStartAddress)
+	{
+		swap = heap_regions[0];
+		heap_regions[0] = heap_regions[1];
+		heap_regions[1] = swap;
+	}
+
+	vPortDefineHeapRegions(heap_regions);
+}
+
+#else
+
+void dd_memory_init(void)
+{
+}
+
+#endif /* configUSE_HEAP_HINTS */
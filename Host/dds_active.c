@@ -0,0 +1,219 @@
+/**
+  ******************************************************************************
+  * @file    dds_active.c
+  * @brief   Host benchmark of the DD scheduler message cost against the number
+  *          of active DD tasks.
+  *
+  *          A task keeps 1, 10, 100 and then 1000 DD tasks active in the
+  *          deadline heap of src/dd_task.c and handles [rounds] release and
+  *          completion messages at each size, the way dd_task_scheduler()
+  *          does: the message is pushed into and popped from a dd_ring,
+  *          the task is inserted into or removed from the active heap by its
+  *          heap index, and the earliest deadline is peeked for dispatch.
+  *          Every message is timed from its push until the new earliest
+  *          deadline is known.
+  *
+  *          Usage: dds_active [rounds]
+  *
+  *          The kernel calls that follow a dispatch (a priority or deadline
+  *          change and a context switch) are left out, they cost the same
+  *          whatever the number of active tasks.
+  ******************************************************************************
+  */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "dd_task.h"
+#include "dd_ring.h"
+
+#include "bench.h"
+
+#define benchMAX_ACTIVE						1000
+#define benchRING_LENGTH					32
+#define benchDEFAULT_ROUNDS					100000
+#define benchMAX_SAMPLES					(1 << 20)
+#define benchMAX_DEADLINE					10000
+#define benchTASK_PRIORITY					( configMAX_PRIORITIES - 1 )
+
+typedef enum bench_message_type
+{
+	BENCH_RELEASE,
+	BENCH_COMPLETE
+} bench_message_type_t;
+
+typedef struct bench_message
+{
+	bench_message_type_t message_type;
+	dd_task_info_t *ptask_info;
+} bench_message_t;
+
+static const uint32_t active_counts[] = { 1, 10, 100, benchMAX_ACTIVE };
+
+// Task infos outside the heap wait on a stack for their next release
+static dd_task_info_t task_infos[benchMAX_ACTIVE + 1];
+static dd_task_info_t *idle_task_infos[benchMAX_ACTIVE + 1];
+static uint32_t idle_count = 0;
+static dd_task_info_t *heap_entries[benchMAX_ACTIVE + 1];
+static dd_task_heap_t active_heap = { heap_entries, 0, benchMAX_ACTIVE + 1 };
+
+static bench_message_t ring_messages[benchRING_LENGTH];
+static uint32_t ring_sequences[benchRING_LENGTH];
+static dd_ring_t message_ring;
+
+static uint32_t round_count = benchDEFAULT_ROUNDS;
+static uint32_t current_time = 0;
+static uint32_t failed_checks = 0;
+
+static uint32_t release_ns[benchMAX_SAMPLES];
+static uint32_t complete_ns[benchMAX_SAMPLES];
+static bench_samples_t release_samples = { release_ns, benchMAX_SAMPLES, 0, 0 };
+static bench_samples_t complete_samples = { complete_ns, benchMAX_SAMPLES, 0, 0 };
+
+static uint64_t random_state = benchRANDOM_SEED;
+
+// The scheduler side of one message, returns the task to dispatch
+static dd_task_info_t *pHandle_message(void)
+{
+	bench_message_t message;
+
+	if(!dd_ring_pop(&message_ring, &message))
+	{
+		failed_checks++;
+		return NULL;
+	}
+
+	if(message.message_type == BENCH_RELEASE)
+	{
+		if(!dd_heap_insert(&active_heap, message.ptask_info))
+		{
+			failed_checks++;
+		}
+	}
+	else if(!dd_heap_remove_task(&active_heap, message.ptask_info))
+	{
+		failed_checks++;
+	}
+
+	return pDd_heap_peek(&active_heap);
+}
+
+static void post_message(bench_message_type_t message_type, dd_task_info_t *ptask_info)
+{
+	bench_message_t message;
+
+	message.message_type = message_type;
+	message.ptask_info = ptask_info;
+
+	if(!dd_ring_push(&message_ring, &message))
+	{
+		failed_checks++;
+	}
+}
+
+static dd_task_info_t *pNext_release(void)
+{
+	dd_task_info_t *ptask_info = idle_task_infos[--idle_count];
+
+	current_time++;
+	ptask_info->absolute_deadline = current_time + 1 + (bench_random_next(&random_state) % benchMAX_DEADLINE);
+
+	return ptask_info;
+}
+
+// Release one task and complete a random active one, the heap keeps its size
+static void run_round(void)
+{
+	dd_task_info_t *preleased = pNext_release();
+	dd_task_info_t *pcompleted;
+	dd_task_info_t *pearliest;
+	uint64_t start;
+
+	start = bench_now_ns();
+	post_message(BENCH_RELEASE, preleased);
+	pearliest = pHandle_message();
+	bench_add_sample(&release_samples, bench_now_ns() - start);
+
+	if((pearliest == NULL) || deadline_is_earlier(preleased, pearliest))
+	{
+		failed_checks++;
+	}
+
+	pcompleted = active_heap.pentries[bench_random_next(&random_state) % active_heap.length];
+
+	start = bench_now_ns();
+	post_message(BENCH_COMPLETE, pcompleted);
+	pearliest = pHandle_message();
+	bench_add_sample(&complete_samples, bench_now_ns() - start);
+
+	if((pcompleted->heap_index != heapINDEX_NONE) || (pearliest != pDd_heap_peek(&active_heap)))
+	{
+		failed_checks++;
+	}
+
+	idle_task_infos[idle_count++] = pcompleted;
+}
+
+static void bench_task(void *pvParameters)
+{
+	uint32_t size_index;
+	uint32_t round;
+	char label[32];
+
+	(void) pvParameters;
+
+	dd_ring_init(&message_ring, ring_messages, ring_sequences, sizeof(bench_message_t), benchRING_LENGTH);
+
+	for(size_index = 0; size_index < sizeof(active_counts) / sizeof(active_counts[0]); size_index++)
+	{
+		while(active_heap.length < active_counts[size_index])
+		{
+			(void) dd_heap_insert(&active_heap, pNext_release());
+		}
+
+		for(round = 0; round < round_count; round++)
+		{
+			run_round();
+		}
+
+		snprintf(label, sizeof(label), "Active (%4u tasks)", active_counts[size_index]);
+		bench_report_samples(label, "release", "messages", &release_samples);
+		bench_report_samples(label, "completion", "messages", &complete_samples);
+	}
+
+	printf("Active: %u checks failed\n", failed_checks);
+
+	exit((failed_checks == 0) ? 0 : 1);
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t index;
+
+	if(argc > 1)
+	{
+		round_count = (uint32_t)strtoul(argv[1], NULL, 10);
+	}
+
+	if((round_count == 0) || (round_count > benchMAX_SAMPLES))
+	{
+		fprintf(stderr, "usage: %s [rounds 1..%d]\n", argv[0], benchMAX_SAMPLES);
+		return 2;
+	}
+
+	for(index = 0; index <= benchMAX_ACTIVE; index++)
+	{
+		task_infos[index].task_id = index;
+		task_infos[index].heap_index = heapINDEX_NONE;
+		idle_task_infos[idle_count++] = &task_infos[index];
+	}
+
+	xTaskCreate(bench_task, "Bench", configMINIMAL_STACK_SIZE * 2, NULL, benchTASK_PRIORITY, NULL);
+	vTaskStartScheduler();
+
+	return 1;
+}
@@ -0,0 +1,197 @@
+/**
+  ******************************************************************************
+  * @file    dds_admission.c
+  * @brief   Host benchmark of the DD scheduler admission control.
+  *
+  *          Generates random periodic task sets with constrained deadlines
+  *          and admits their tasks one by one through src/dd_admission.c,
+  *          as the DD scheduler does on the first release of each task.
+  *          Reports how many tasks were admitted and how long a decision
+  *          takes, overall and for the decisions that needed the full
+  *          processor-demand test.
+  *
+  *          Usage: dds_admission [tasks per set] [task sets] [utilization %]
+  *
+  *          Utilizations are split with UUniFast, periods are log-uniform
+  *          in [1000, 1000000] ticks and every deadline is drawn uniformly
+  *          from [(C + T) / 2, T].
+  ******************************************************************************
+  */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <math.h>
+#include <time.h>
+
+#include "dd_admission.h"
+
+#define benchMAX_TASKS						4096
+#define benchDEFAULT_TASKS					100
+#define benchDEFAULT_TASK_SETS				1000
+#define benchDEFAULT_UTILIZATION			90
+#define benchMIN_PERIOD						1000.0
+#define benchMAX_PERIOD						1000000.0
+
+typedef struct bench_task
+{
+	uint32_t period;
+	uint32_t execution_time;
+	uint32_t relative_deadline;
+} bench_task_t;
+
+static bench_task_t bench_tasks[benchMAX_TASKS];
+static dd_admission_task_t admission_storage[benchMAX_TASKS];
+
+static uint64_t random_state = 0x9E3779B97F4A7C15ULL;
+
+// xorshift64*, uniform in [0, 1)
+static double random_uniform(void)
+{
+	random_state ^= random_state >> 12;
+	random_state ^= random_state << 25;
+	random_state ^= random_state >> 27;
+
+	return (double)((random_state * 0x2545F4914F6CDD1DULL) >> 11) / 9007199254740992.0;
+}
+
+static void generate_task_set(uint32_t task_count, double utilization)
+{
+	double remaining = utilization;
+	double next_remaining;
+	double task_utilization;
+	double period;
+	uint32_t index;
+
+	for(index = 0; index < task_count; index++)
+	{
+		// UUniFast (Bini and Buttazzo, 2005)
+		if(index + 1 < task_count)
+		{
+			next_remaining = remaining * pow(random_uniform(), 1.0 / (double)(task_count - index - 1));
+			task_utilization = remaining - next_remaining;
+			remaining = next_remaining;
+		}
+		else
+		{
+			task_utilization = remaining;
+		}
+
+		period = exp(log(benchMIN_PERIOD) + (random_uniform() * (log(benchMAX_PERIOD) - log(benchMIN_PERIOD))));
+
+		bench_tasks[index].period = (uint32_t)period;
+		bench_tasks[index].execution_time = (uint32_t)(task_utilization * period);
+
+		if(bench_tasks[index].execution_time == 0)
+		{
+			bench_tasks[index].execution_time = 1;
+		}
+
+		bench_tasks[index].relative_deadline = bench_tasks[index].execution_time +
+			(uint32_t)((0.5 + (0.5 * random_uniform())) * (double)(bench_tasks[index].period - bench_tasks[index].execution_time));
+	}
+}
+
+static uint64_t elapsed_ns(struct timespec *pstart, struct timespec *pend)
+{
+	return ((uint64_t)(pend->tv_sec - pstart->tv_sec) * 1000000000ULL) + (uint64_t)pend->tv_nsec - (uint64_t)pstart->tv_nsec;
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t task_count = benchDEFAULT_TASKS;
+	uint32_t task_sets = benchDEFAULT_TASK_SETS;
+	uint32_t utilization_percent = benchDEFAULT_UTILIZATION;
+	dd_admission_t admission;
+	struct timespec start;
+	struct timespec end;
+	uint64_t decision_ns;
+	uint64_t decisions = 0;
+	uint64_t admitted = 0;
+	uint64_t total_ns = 0;
+	uint64_t max_ns = 0;
+	uint64_t demand_decisions = 0;
+	uint64_t demand_total_ns = 0;
+	uint64_t demand_max_ns = 0;
+	uint32_t demand_tests;
+	uint32_t task_set;
+	uint32_t index;
+
+	if(argc > 4)
+	{
+		fprintf(stderr, "usage: %s [tasks per set] [task sets] [utilization %%]\n", argv[0]);
+		return 2;
+	}
+
+	if(argc > 1)
+	{
+		task_count = (uint32_t)strtoul(argv[1], NULL, 0);
+	}
+
+	if(argc > 2)
+	{
+		task_sets = (uint32_t)strtoul(argv[2], NULL, 0);
+	}
+
+	if(argc > 3)
+	{
+		utilization_percent = (uint32_t)strtoul(argv[3], NULL, 0);
+	}
+
+	if((task_count == 0) || (task_count > benchMAX_TASKS) || (task_sets == 0) || (utilization_percent == 0) || (utilization_percent > 100))
+	{
+		fprintf(stderr, "dds_admission: 1..%d tasks per set, at least one task set, utilization 1..100%%\n", benchMAX_TASKS);
+		return 2;
+	}
+
+	printf("Admitting %u task sets of %u periodic tasks, utilization = %u%%\n", task_sets, task_count, utilization_percent);
+
+	for(task_set = 0; task_set < task_sets; task_set++)
+	{
+		generate_task_set(task_count, (double)utilization_percent / 100.0);
+		dd_admission_init(&admission, admission_storage, task_count);
+
+		for(index = 0; index < task_count; index++)
+		{
+			demand_tests = admission.demand_tests;
+
+			clock_gettime(CLOCK_MONOTONIC, &start);
+
+			if(dd_admit_periodic_task(&admission, index, bench_tasks[index].period, bench_tasks[index].execution_time, bench_tasks[index].relative_deadline))
+			{
+				admitted++;
+			}
+
+			clock_gettime(CLOCK_MONOTONIC, &end);
+
+			decision_ns = elapsed_ns(&start, &end);
+			decisions++;
+			total_ns += decision_ns;
+			max_ns = (decision_ns > max_ns) ? decision_ns : max_ns;
+
+			if(admission.demand_tests != demand_tests)
+			{
+				demand_decisions++;
+				demand_total_ns += decision_ns;
+				demand_max_ns = (decision_ns > demand_max_ns) ? decision_ns : demand_max_ns;
+			}
+		}
+	}
+
+	printf("Admitted %" PRIu64 " of %" PRIu64 " tasks (%.1f%%)\n", admitted, decisions, 100.0 * (double)admitted / (double)decisions);
+	printf("Decision time: mean = %.0f ns, max = %" PRIu64 " ns\n", (double)total_ns / (double)decisions, max_ns);
+
+	if(demand_decisions > 0)
+	{
+		printf("Processor-demand test: %" PRIu64 " decisions, mean = %.0f ns, max = %" PRIu64 " ns\n",
+			demand_decisions, (double)demand_total_ns / (double)demand_decisions, demand_max_ns);
+	}
+	else
+	{
+		printf("Processor-demand test: never needed\n");
+	}
+
+	return 0;
+}
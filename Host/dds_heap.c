@@ -0,0 +1,150 @@
+/**
+  ******************************************************************************
+  * @file    dds_heap.c
+  * @brief   Host benchmark of the FreeRTOS heap implementations.
+  *
+  *          Built twice, once with FreeRTOS_Source/portable/MemMang/heap_4.c
+  *          (first fit over an address ordered free list) and once with
+  *          heap_6.c (two level segregated fit), benchHEAP says which.
+  *
+  *          A task fills benchSLOTS slots with blocks of random size, then
+  *          frees a random slot and allocates it again with a new random size
+  *          [rounds] times, the steady churn of the DDS creating and deleting
+  *          kernel objects. Every pvPortMalloc() and vPortFree() is timed, and
+  *          the free blocks are reported with vPortGetHeapStats() at the end.
+  *
+  *          Usage: dds_heap [rounds]
+  *
+  *          Sizes: 70% 16..255 bytes (queues, timers, small buffers), 27%
+  *          256..1023 bytes (TCBs, stacks) and 3% 1024..4095 bytes (large
+  *          stacks and buffers), about 70% of the host heap in use.
+  ******************************************************************************
+  */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "bench.h"
+
+#define benchSLOTS							512
+#define benchDEFAULT_ROUNDS					200000
+#define benchMAX_SAMPLES					(1 << 20)
+#define benchTASK_PRIORITY					( configMAX_PRIORITIES - 1 )
+
+#ifndef benchHEAP
+	#define benchHEAP						4
+#endif
+
+static void *slots[benchSLOTS];
+static uint32_t round_count = benchDEFAULT_ROUNDS;
+static uint32_t failed_count = 0;
+
+static uint32_t malloc_ns[benchMAX_SAMPLES];
+static uint32_t free_ns[benchMAX_SAMPLES];
+static bench_samples_t malloc_samples = { malloc_ns, benchMAX_SAMPLES, 0, 0 };
+static bench_samples_t free_samples = { free_ns, benchMAX_SAMPLES, 0, 0 };
+
+static uint64_t random_state = benchRANDOM_SEED;
+
+static size_t random_size(void)
+{
+	uint32_t size_class = bench_random_next(&random_state) % 100;
+
+	if(size_class < 70)
+	{
+		return 16 + (bench_random_next(&random_state) % 240);
+	}
+	else if(size_class < 97)
+	{
+		return 256 + (bench_random_next(&random_state) % 768);
+	}
+
+	return 1024 + (bench_random_next(&random_state) % 3072);
+}
+
+static void *timed_malloc(size_t size)
+{
+	uint64_t start = bench_now_ns();
+	void *pblock = pvPortMalloc(size);
+
+	bench_add_sample(&malloc_samples, bench_now_ns() - start);
+
+	return pblock;
+}
+
+static void timed_free(void *pblock)
+{
+	uint64_t start = bench_now_ns();
+
+	vPortFree(pblock);
+	bench_add_sample(&free_samples, bench_now_ns() - start);
+}
+
+static void bench_task(void *pvParameters)
+{
+	HeapStats_t heap_stats;
+	char label[16];
+	uint32_t index;
+	uint32_t round;
+
+	(void) pvParameters;
+
+	for(index = 0; index < benchSLOTS; index++)
+	{
+		slots[index] = pvPortMalloc(random_size());
+	}
+
+	for(round = 0; round < round_count; round++)
+	{
+		index = bench_random_next(&random_state) % benchSLOTS;
+
+		if(slots[index] != NULL)
+		{
+			timed_free(slots[index]);
+		}
+
+		slots[index] = timed_malloc(random_size());
+	}
+
+	vPortGetHeapStats(&heap_stats);
+
+	snprintf(label, sizeof(label), "Heap (heap_%d)", benchHEAP);
+	bench_report_samples(label, "pvPortMalloc", "calls", &malloc_samples);
+	bench_report_samples(label, "vPortFree", "calls", &free_samples);
+	printf("Heap (heap_%d): %u failed allocations, %u free blocks, %u of %u free bytes in the largest, fragmentation %.1f%%, minimum ever free %u bytes\n",
+		benchHEAP, failed_count, (uint32_t)heap_stats.xNumberOfFreeBlocks, (uint32_t)heap_stats.xSizeOfLargestFreeBlockInBytes,
+		(uint32_t)heap_stats.xAvailableHeapSpaceInBytes,
+		100.0 * (1.0 - ((double)heap_stats.xSizeOfLargestFreeBlockInBytes / (double)heap_stats.xAvailableHeapSpaceInBytes)),
+		(uint32_t)heap_stats.xMinimumEverFreeBytesRemaining);
+
+	exit(0);
+}
+
+int main(int argc, char **argv)
+{
+	if(argc > 1)
+	{
+		round_count = (uint32_t)strtoul(argv[1], NULL, 10);
+	}
+
+	if((round_count == 0) || (round_count > benchMAX_SAMPLES))
+	{
+		fprintf(stderr, "usage: %s [rounds 1..%d]\n", argv[0], benchMAX_SAMPLES);
+		return 2;
+	}
+
+	xTaskCreate(bench_task, "Bench", configMINIMAL_STACK_SIZE * 2, NULL, benchTASK_PRIORITY, NULL);
+	vTaskStartScheduler();
+
+	return 1;
+}
+
+// A full heap is part of the benchmark, count it rather than stop
+void vApplicationMallocFailedHook(void)
+{
+	failed_count++;
+}
@@ -0,0 +1,241 @@
+/**
+  ******************************************************************************
+  * @file    dds_lists.c
+  * @brief   Host benchmark of the FreeRTOS sorted list insertion.
+  *
+  *          Built twice against FreeRTOS_Source/list.c, once with the linear
+  *          vListInsert() walk (configUSE_TREE_INDEXED_LISTS 0) and once
+  *          with the red-black tree index (configUSE_TREE_INDEXED_LISTS 1).
+  *
+  *          1.	Sorted list churn: for every list length, removes a random
+  *				item and inserts it again with a new random value, then
+  *				checks that the list is in value order and that equal values
+  *				kept their insertion order.
+  *          2.	Kernel: benchTASKS tasks sleep for random delays, so the
+  *				delayed task list holds about that many tasks. vListInsert()
+  *				and xTaskIncrementTick() are wrapped at link time
+  *				(-Wl,--wrap) and every call is timed, the tick samples being
+  *				the tick interrupt cost of unblocking tasks.
+  *
+  *          Usage: dds_lists [tasks] [seconds]
+  ******************************************************************************
+  */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "list.h"
+#include "task.h"
+
+#include "bench.h"
+
+#define benchMAX_ITEMS						10000
+#define benchCHURN							200000
+#define benchMAX_TASKS						1000
+#define benchDEFAULT_TASKS					500
+#define benchDEFAULT_SECONDS				10
+#define benchMAX_DELAY						2000
+#define benchMAX_SAMPLES					(1 << 20)
+#define benchTASK_PRIORITY					1
+#define benchREPORT_PRIORITY				( configMAX_PRIORITIES - 1 )
+
+#if ( configUSE_TREE_INDEXED_LISTS == 1 )
+	#define benchBACKEND					"tree"
+#else
+	#define benchBACKEND					"linear"
+#endif
+
+typedef struct bench_item
+{
+	ListItem_t list_item;
+	uint32_t sequence;
+} bench_item_t;
+
+void __real_vListInsert(List_t * const pxList, ListItem_t * const pxNewListItem);
+BaseType_t __real_xTaskIncrementTick(void);
+
+static bench_item_t items[benchMAX_ITEMS];
+static List_t bench_list;
+static const uint32_t list_lengths[] = { 10, 100, 1000, benchMAX_ITEMS };
+
+static StaticTask_t task_tcbs[benchMAX_TASKS];
+static StackType_t task_stacks[benchMAX_TASKS][configMINIMAL_STACK_SIZE];
+static uint32_t task_count = benchDEFAULT_TASKS;
+static uint32_t run_seconds = benchDEFAULT_SECONDS;
+
+static uint32_t insert_ns[benchMAX_SAMPLES];
+static uint32_t tick_ns[benchMAX_SAMPLES];
+static bench_samples_t insert_samples = { insert_ns, benchMAX_SAMPLES, 0, 0 };
+static bench_samples_t tick_samples = { tick_ns, benchMAX_SAMPLES, 0, 0 };
+static volatile int kernel_started = 0;
+
+static uint64_t random_state = benchRANDOM_SEED;
+
+// Value order, and insertion order among equal values
+static int list_is_ordered(void)
+{
+	const ListItem_t *pitem = listGET_HEAD_ENTRY(&bench_list);
+	const ListItem_t *pend = listGET_END_MARKER(&bench_list);
+	const bench_item_t *pprevious = NULL;
+	const bench_item_t *pcurrent;
+
+	while(pitem != pend)
+	{
+		pcurrent = (const bench_item_t *)listGET_LIST_ITEM_OWNER(pitem);
+
+		if((pprevious != NULL) && ((pprevious->list_item.xItemValue > pcurrent->list_item.xItemValue) ||
+			((pprevious->list_item.xItemValue == pcurrent->list_item.xItemValue) && (pprevious->sequence > pcurrent->sequence))))
+		{
+			return 0;
+		}
+
+		pprevious = pcurrent;
+		pitem = listGET_NEXT(pitem);
+	}
+
+	return 1;
+}
+
+static int churn_list(uint32_t length)
+{
+	uint32_t sequence = 0;
+	uint32_t index;
+	uint32_t round;
+	bench_item_t *pitem;
+	uint64_t start;
+	uint64_t elapsed;
+	uint64_t worst = 0;
+	uint64_t total = 0;
+
+	vListInitialise(&bench_list);
+
+	// Values drawn from 4 * length keep some equal values in the list
+	for(index = 0; index < length; index++)
+	{
+		vListInitialiseItem(&items[index].list_item);
+		listSET_LIST_ITEM_OWNER(&items[index].list_item, &items[index]);
+		listSET_LIST_ITEM_VALUE(&items[index].list_item, bench_random_next(&random_state) % (4 * length));
+		items[index].sequence = sequence++;
+		__real_vListInsert(&bench_list, &items[index].list_item);
+	}
+
+	for(round = 0; round < benchCHURN; round++)
+	{
+		pitem = &items[bench_random_next(&random_state) % length];
+		listSET_LIST_ITEM_VALUE(&pitem->list_item, bench_random_next(&random_state) % (4 * length));
+		pitem->sequence = sequence++;
+
+		start = bench_now_ns();
+		(void) uxListRemove(&pitem->list_item);
+		__real_vListInsert(&bench_list, &pitem->list_item);
+		elapsed = bench_now_ns() - start;
+
+		total += elapsed;
+		worst = (elapsed > worst) ? elapsed : worst;
+	}
+
+	printf("Lists (%s): %5u items, remove + insert mean %6.0f ns, max %7u ns\n", benchBACKEND, length, (double)total / (double)benchCHURN, (uint32_t)worst);
+
+	return list_is_ordered();
+}
+
+void __wrap_vListInsert(List_t * const pxList, ListItem_t * const pxNewListItem)
+{
+	uint64_t start = bench_now_ns();
+
+	__real_vListInsert(pxList, pxNewListItem);
+
+	if(kernel_started)
+	{
+		bench_add_sample(&insert_samples, bench_now_ns() - start);
+	}
+}
+
+BaseType_t __wrap_xTaskIncrementTick(void)
+{
+	uint64_t start = bench_now_ns();
+	BaseType_t switch_required = __real_xTaskIncrementTick();
+
+	bench_add_sample(&tick_samples, bench_now_ns() - start);
+
+	return switch_required;
+}
+
+static void sleeper_task(void *pvParameters)
+{
+	uint64_t state = benchRANDOM_SEED + (uint64_t)(uintptr_t)pvParameters;
+
+	while(1)
+	{
+		vTaskDelay(1 + (TickType_t)(bench_random_next(&state) % benchMAX_DELAY));
+	}
+}
+
+static void report_task(void *pvParameters)
+{
+	(void) pvParameters;
+
+	// Let the sleepers fill the delayed list before sampling
+	vTaskDelay(benchMAX_DELAY);
+	taskENTER_CRITICAL();
+	insert_samples.count = 0;
+	insert_samples.total = 0;
+	tick_samples.count = 0;
+	tick_samples.total = 0;
+	kernel_started = 1;
+	taskEXIT_CRITICAL();
+
+	vTaskDelay(run_seconds * configTICK_RATE_HZ);
+
+	taskENTER_CRITICAL();
+	kernel_started = 0;
+	printf("Lists (%s): kernel with %u sleeping tasks\n", benchBACKEND, task_count);
+	bench_report_samples("Lists (" benchBACKEND ")", "vListInsert", "calls", &insert_samples);
+	bench_report_samples("Lists (" benchBACKEND ")", "tick", "calls", &tick_samples);
+	exit(0);
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t index;
+	int ordered = 1;
+
+	if(argc > 1)
+	{
+		task_count = (uint32_t)strtoul(argv[1], NULL, 10);
+	}
+
+	if(argc > 2)
+	{
+		run_seconds = (uint32_t)strtoul(argv[2], NULL, 10);
+	}
+
+	if((task_count == 0) || (task_count > benchMAX_TASKS))
+	{
+		fprintf(stderr, "usage: %s [tasks 1..%d] [seconds]\n", argv[0], benchMAX_TASKS);
+		return 2;
+	}
+
+	for(index = 0; index < sizeof(list_lengths) / sizeof(list_lengths[0]); index++)
+	{
+		ordered &= churn_list(list_lengths[index]);
+	}
+
+	if(!ordered)
+	{
+		printf("Lists (%s): list order broken\n", benchBACKEND);
+		return 1;
+	}
+
+	for(index = 0; index < task_count; index++)
+	{
+		xTaskCreateStatic(sleeper_task, "Sleeper", configMINIMAL_STACK_SIZE, (void *)(uintptr_t)index, benchTASK_PRIORITY, task_stacks[index], &task_tcbs[index]);
+	}
+
+	xTaskCreate(report_task, "Report", configMINIMAL_STACK_SIZE * 2, NULL, benchREPORT_PRIORITY, NULL);
+	vTaskStartScheduler();
+
+	return 1;
+}
@@ -0,0 +1,374 @@
+/**
+  ******************************************************************************
+  * @file    dds_ordering.c
+  * @brief   Checks a dump of the DD binary trace (src/dd_trace.h) for EDF
+  *          ordering.
+  *
+  *          Replays the DD scheduler events to know, at every moment, which
+  *          jobs are released and not yet completed, whether they are still
+  *          active or overdue, their absolute deadlines and the worker each
+  *          one was handed to. Two orders are checked:
+  *
+  *          1.	a worker switched in runs the earliest deadline job of those
+  *				holding a worker, a late job only while no active job holds one.
+  *          2.	a worker is handed the earliest deadline active job waiting
+  *				for one, a late job only while no active job waits.
+  *
+  *          Usage: dds_ordering <dump file>
+  *
+  *          Jobs released before the oldest record in the ring are unknown
+  *          and not checked. Exits with 1 if a switch-in or a hand-off broke
+  *          EDF order, if no switch-in could be checked or if fewer than
+  *          orderingMIN_DD_TASKS DD tasks completed a job.
+  ******************************************************************************
+  */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "dd_trace.h"
+
+#define orderingMAX_JOBS					64
+#define orderingMAX_DD_TASKS				256
+#define orderingMIN_DD_TASKS				3
+
+typedef enum job_state
+{
+	JOB_FREE,
+	JOB_ACTIVE,
+	JOB_OVERDUE
+} job_state_t;
+
+typedef struct ordering_job
+{
+	job_state_t state;
+	uint32_t task_id;
+	uint32_t absolute_deadline;
+	uint32_t worker;						// kernel task number, 0 until handed to a worker
+	uint32_t release_sequence;
+} ordering_job_t;
+
+// The dump header, its ring is read into pring_records whatever length the DDS was built with
+static dd_trace_t trace;
+static dd_trace_record_t *pring_records;
+static dd_trace_record_t *precords;
+static ordering_job_t jobs[orderingMAX_JOBS];
+// Worker dispatched before the release was recorded, per DD task
+static uint32_t early_dispatch[orderingMAX_DD_TASKS];
+static uint32_t completed_jobs[orderingMAX_DD_TASKS];
+
+static uint32_t checked_switches = 0;
+static uint32_t checked_dispatches = 0;
+static uint32_t violations = 0;
+static uint32_t lost_jobs = 0;
+
+static int compare_records(const void *pfirst, const void *psecond)
+{
+	uint32_t first = ((const dd_trace_record_t *)pfirst)->sequence;
+	uint32_t second = ((const dd_trace_record_t *)psecond)->sequence;
+
+	return (first < second) ? -1 : ((first > second) ? 1 : 0);
+}
+
+// Oldest job of task_id in state, with the given worker unless worker is 0
+static ordering_job_t *pFind_job(uint32_t task_id, job_state_t state, uint32_t worker)
+{
+	ordering_job_t *poldest = NULL;
+	uint32_t index;
+
+	for(index = 0; index < orderingMAX_JOBS; index++)
+	{
+		if((jobs[index].state == state) && (jobs[index].task_id == task_id) && ((worker == 0) || (jobs[index].worker == worker)) &&
+			((poldest == NULL) || ((int32_t)(jobs[index].release_sequence - poldest->release_sequence) < 0)))
+		{
+			poldest = &jobs[index];
+		}
+	}
+
+	return poldest;
+}
+
+static ordering_job_t *pFind_worker_job(uint32_t worker)
+{
+	uint32_t index;
+
+	for(index = 0; index < orderingMAX_JOBS; index++)
+	{
+		if((jobs[index].state != JOB_FREE) && (jobs[index].worker == worker))
+		{
+			return &jobs[index];
+		}
+	}
+
+	return NULL;
+}
+
+static void check_dispatch(ordering_job_t *pjob, double timestamp);
+
+static void release_job(dd_trace_record_t *precord, double timestamp)
+{
+	uint32_t index;
+
+	for(index = 0; index < orderingMAX_JOBS; index++)
+	{
+		if(jobs[index].state == JOB_FREE)
+		{
+			jobs[index].state = JOB_ACTIVE;
+			jobs[index].task_id = precord->task;
+			jobs[index].absolute_deadline = precord->argument;
+			jobs[index].worker = early_dispatch[precord->task];
+			jobs[index].release_sequence = precord->sequence;
+			early_dispatch[precord->task] = 0;
+
+			if(jobs[index].worker != 0)
+			{
+				check_dispatch(&jobs[index], timestamp);
+			}
+			return;
+		}
+	}
+
+	lost_jobs++;
+}
+
+static void report_violation(const char *paction, ordering_job_t *pfirst, ordering_job_t *psecond, double timestamp)
+{
+	printf("Ordering: at %.3f ms %stask %u (deadline %u) %s before task %u (deadline %u)\n", timestamp / 1000.0,
+		(pfirst->state == JOB_OVERDUE) ? "late " : "", pfirst->task_id, pfirst->absolute_deadline, paction,
+		psecond->task_id, psecond->absolute_deadline);
+	violations++;
+}
+
+// Whether pwaiting, an active job, should go before pjob
+static int goes_before(ordering_job_t *pwaiting, ordering_job_t *pjob)
+{
+	return (pjob->state != JOB_ACTIVE) || ((int32_t)(pwaiting->absolute_deadline - pjob->absolute_deadline) < 0);
+}
+
+// Every active job without a worker must not go before the job just handed one
+static void check_dispatch(ordering_job_t *pjob, double timestamp)
+{
+	uint32_t index;
+
+	checked_dispatches++;
+
+	for(index = 0; index < orderingMAX_JOBS; index++)
+	{
+		if((jobs[index].state == JOB_ACTIVE) && (jobs[index].worker == 0) && (&jobs[index] != pjob) && goes_before(&jobs[index], pjob))
+		{
+			report_violation("gets a worker", pjob, &jobs[index], timestamp);
+		}
+	}
+}
+
+// A job is handed to its worker once, before its release is recorded when a
+// worker is idle, later when it waited for one. The record names the DD task,
+// not the job: it is the task's oldest active job waiting for a worker, or its
+// oldest late one when none is active, the job src/dd_worker.c picks.
+static void dispatch_job(dd_trace_record_t *precord, double timestamp)
+{
+	ordering_job_t *pjob = pFind_job(precord->task, JOB_ACTIVE, 0);
+	ordering_job_t *pprevious;
+
+	if((pjob == NULL) || (pjob->worker != 0))
+	{
+		pjob = pFind_job(precord->task, JOB_OVERDUE, 0);
+	}
+
+	if((pjob == NULL) || (pjob->worker != 0))
+	{
+		early_dispatch[precord->task] = precord->argument;
+		return;
+	}
+
+	// A worker runs one job at a time
+	pprevious = pFind_worker_job(precord->argument);
+
+	if(pprevious != NULL)
+	{
+		pprevious->worker = 0;
+	}
+
+	pjob->worker = precord->argument;
+	check_dispatch(pjob, timestamp);
+}
+
+// The completing worker was the last one switched in before the scheduler
+static void complete_job(dd_trace_record_t *precord, uint32_t last_worker)
+{
+	ordering_job_t *pjob = pFind_worker_job(last_worker);
+
+	if((pjob == NULL) || (pjob->task_id != precord->task))
+	{
+		pjob = pFind_job(precord->task, JOB_ACTIVE, 0);
+	}
+
+	if(pjob == NULL)
+	{
+		pjob = pFind_job(precord->task, JOB_OVERDUE, 0);
+	}
+
+	completed_jobs[precord->task]++;
+
+	if(pjob != NULL)
+	{
+		pjob->state = JOB_FREE;
+	}
+}
+
+// Every active job holding a worker must not go before the job switched in
+static void check_switch_in(dd_trace_record_t *precord, double timestamp)
+{
+	ordering_job_t *prunning = pFind_worker_job(precord->task);
+	uint32_t index;
+
+	if(prunning == NULL)
+	{
+		return;
+	}
+
+	checked_switches++;
+
+	for(index = 0; index < orderingMAX_JOBS; index++)
+	{
+		if((jobs[index].state == JOB_ACTIVE) && (jobs[index].worker != 0) && (&jobs[index] != prunning) && goes_before(&jobs[index], prunning))
+		{
+			report_violation("runs", prunning, &jobs[index], timestamp);
+		}
+	}
+}
+
+int main(int argc, char **argv)
+{
+	FILE *pinput;
+	uint32_t record_count = 0;
+	uint32_t last_worker = 0;
+	uint32_t task_count = 0;
+	uint64_t base_timestamp;
+	uint32_t index;
+	dd_trace_record_t *precord;
+	ordering_job_t *pjob;
+	double timestamp;
+
+	if(argc != 2)
+	{
+		fprintf(stderr, "usage: %s <dump file>\n", argv[0]);
+		return 2;
+	}
+
+	pinput = fopen(argv[1], "rb");
+
+	if(pinput == NULL)
+	{
+		fprintf(stderr, "dds_ordering: cannot open %s\n", argv[1]);
+		return 2;
+	}
+
+	if(fread(&trace, offsetof(dd_trace_t, ring), 1, pinput) != 1)
+	{
+		fprintf(stderr, "dds_ordering: %s is shorter than a trace dump\n", argv[1]);
+		fclose(pinput);
+		return 2;
+	}
+
+	if((trace.magic != traceMAGIC) || (trace.version != traceVERSION) || (trace.record_size != sizeof(dd_trace_record_t)) ||
+		(trace.ring_length == 0) || ((trace.ring_length & (trace.ring_length - 1)) != 0) ||
+		(trace.task_name_length != traceTASK_NAME_LENGTH) || (trace.cycles_per_us == 0))
+	{
+		fprintf(stderr, "dds_ordering: %s is not a version %d trace dump of this layout\n", argv[1], traceVERSION);
+		fclose(pinput);
+		return 2;
+	}
+
+	pring_records = (dd_trace_record_t *)malloc(trace.ring_length * sizeof(dd_trace_record_t));
+	precords = (dd_trace_record_t *)malloc(trace.ring_length * sizeof(dd_trace_record_t));
+
+	if((pring_records == NULL) || (precords == NULL) || (fread(pring_records, sizeof(dd_trace_record_t), trace.ring_length, pinput) != trace.ring_length))
+	{
+		fprintf(stderr, "dds_ordering: %s is shorter than its %u record ring\n", argv[1], trace.ring_length);
+		fclose(pinput);
+		return 2;
+	}
+
+	fclose(pinput);
+
+	// A slot holds a complete record only when its sequence maps back to the slot
+	for(index = 0; index < trace.ring_length; index++)
+	{
+		if((pring_records[index].sequence != 0) && (((pring_records[index].sequence - 1) & (trace.ring_length - 1)) == index))
+		{
+			precords[record_count++] = pring_records[index];
+		}
+	}
+
+	qsort(precords, record_count, sizeof(dd_trace_record_t), compare_records);
+	base_timestamp = (record_count > 0) ? precords[0].timestamp : 0;
+
+	for(index = 0; index < record_count; index++)
+	{
+		precord = &precords[index];
+		timestamp = (double)(precord->timestamp - base_timestamp) / (double)trace.cycles_per_us;
+
+		if((precord->event >= TRACE_DD_RELEASE) && (precord->task >= orderingMAX_DD_TASKS))
+		{
+			continue;
+		}
+
+		switch(precord->event)
+		{
+			case TRACE_DD_RELEASE:
+				release_job(precord, timestamp);
+				break;
+
+			case TRACE_DD_DISPATCH:
+				dispatch_job(precord, timestamp);
+				break;
+
+			case TRACE_DD_COMPLETE:
+				complete_job(precord, last_worker);
+				break;
+
+			case TRACE_DD_OVERDUE:
+				pjob = pFind_job(precord->task, JOB_ACTIVE, 0);
+
+				if(pjob != NULL)
+				{
+					pjob->state = JOB_OVERDUE;
+				}
+				break;
+
+			case TRACE_TASK_SWITCHED_IN:
+				check_switch_in(precord, timestamp);
+
+				if(pFind_worker_job(precord->task) != NULL)
+				{
+					last_worker = precord->task;
+				}
+				break;
+
+			default:
+				break;
+		}
+	}
+
+	for(index = 0; index < orderingMAX_DD_TASKS; index++)
+	{
+		if(completed_jobs[index] > 0)
+		{
+			printf("Ordering: DD task %u completed %u jobs\n", index, completed_jobs[index]);
+			task_count++;
+		}
+	}
+
+	printf("Ordering: %u records (%u lost to the ring wrapping or torn), %u worker switch-ins and %u hand-offs checked, %u out of EDF order\n",
+		record_count, trace.head - record_count, checked_switches, checked_dispatches, violations);
+
+	if(lost_jobs > 0)
+	{
+		printf("Ordering: %u releases not tracked, more than %d jobs outstanding\n", lost_jobs, orderingMAX_JOBS);
+	}
+
+	return ((violations == 0) && (checked_switches > 0) && (task_count >= orderingMIN_DD_TASKS) && (lost_jobs == 0)) ? 0 : 1;
+}
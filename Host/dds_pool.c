@@ -0,0 +1,250 @@
+/**
+  ******************************************************************************
+  * @file    dds_pool.c
+  * @brief   Host test of the DD task descriptor pool (src/dd_pool.c).
+  *
+  *          benchWORKERS tasks of equal priority share a pool of benchPOOL_LENGTH
+  *          dd_task_info_t, time sliced by the tick. Each releases jobs into
+  *          it and completes a random one of those it holds, up to
+  *          benchHELD at a time, until [cycles] release/complete cycles are
+  *          done between them. Every released descriptor is stamped with its
+  *          owner and job number and the stamp is checked when it completes,
+  *          so a descriptor handed out twice shows up as a foreign stamp.
+  *
+  *          Afterwards the pool must be back where it started: nothing in
+  *          use, every element once on the free stack, no failed allocation
+  *          and no change in the kernel heap. A directed check then replays
+  *          the ABA case: a free head read before three other operations
+  *          left the same element on top must no longer compare equal.
+  *
+  *          Usage: dds_pool [cycles]
+  *
+  *          Prints one line per check and exits with 1 if any failed.
+  ******************************************************************************
+  */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "dd_task.h"
+#include "dd_pool.h"
+
+#include "bench.h"
+
+#define benchWORKERS						4
+#define benchHELD							8
+#define benchPOOL_LENGTH					(benchWORKERS * benchHELD)
+#define benchDEFAULT_CYCLES					1000000
+#define benchWORKER_PRIORITY				( tskIDLE_PRIORITY + 2 )
+#define benchTASK_PRIORITY					( configMAX_PRIORITIES - 1 )
+
+static dd_task_info_t pool_storage[benchPOOL_LENGTH];
+static uint16_t pool_next_free[benchPOOL_LENGTH];
+static dd_pool_t task_info_pool = { (uint8_t *)pool_storage, pool_next_free, sizeof(dd_task_info_t), benchPOOL_LENGTH, 0, 0, 0, 0 };
+
+static TaskHandle_t check_task_handle = NULL;
+static uint32_t cycle_count = benchDEFAULT_CYCLES;
+static volatile uint32_t cycles_left;
+static volatile uint32_t foreign_stamps = 0;
+static volatile uint32_t stray_elements = 0;
+static uint32_t failed_checks = 0;
+
+static void check(const char *pname, int passed)
+{
+	printf("Pool: %-60s %s\n", pname, passed ? "ok" : "FAILED");
+
+	if(!passed)
+	{
+		failed_checks++;
+	}
+}
+
+static void complete_job(dd_task_info_t *ptask_info, uint32_t worker_id, uint32_t job_number)
+{
+	if((ptask_info->task_id != worker_id) || (ptask_info->release_time != job_number))
+	{
+		__atomic_add_fetch(&foreign_stamps, 1, __ATOMIC_RELAXED);
+	}
+
+	dd_pool_free(&task_info_pool, ptask_info);
+}
+
+static void worker_task(void *pvParameters)
+{
+	uint32_t worker_id = (uint32_t)(uintptr_t)pvParameters;
+	// One generator state per worker
+	uint64_t random_state = benchRANDOM_SEED * (worker_id + 1);
+	dd_task_info_t *pheld[benchHELD];
+	uint32_t job_numbers[benchHELD];
+	uint32_t held = 0;
+	uint32_t job_number = 0;
+	uint32_t index;
+	dd_task_info_t *ptask_info;
+
+	while(1)
+	{
+		if((held < benchHELD) && ((held == 0) || (bench_random_next(&random_state) & 1)))
+		{
+			// Release
+			ptask_info = (dd_task_info_t *)pvDd_pool_alloc(&task_info_pool);
+
+			if(ptask_info == NULL)
+			{
+				continue;
+			}
+
+			if((ptask_info < pool_storage) || (ptask_info >= pool_storage + benchPOOL_LENGTH))
+			{
+				__atomic_add_fetch(&stray_elements, 1, __ATOMIC_RELAXED);
+				continue;
+			}
+
+			job_number++;
+			ptask_info->task_id = worker_id;
+			ptask_info->release_time = job_number;
+			pheld[held] = ptask_info;
+			job_numbers[held] = job_number;
+			held++;
+		}
+		else
+		{
+			// Complete, the cycle counter is shared so the workers stop together
+			if(__atomic_sub_fetch(&cycles_left, 1, __ATOMIC_RELAXED) >= cycle_count)
+			{
+				break;
+			}
+
+			index = bench_random_next(&random_state) % held;
+			complete_job(pheld[index], worker_id, job_numbers[index]);
+			held--;
+			pheld[index] = pheld[held];
+			job_numbers[index] = job_numbers[held];
+		}
+	}
+
+	while(held > 0)
+	{
+		held--;
+		complete_job(pheld[held], worker_id, job_numbers[held]);
+	}
+
+	xTaskNotifyGive(check_task_handle);
+	vTaskDelete(NULL);
+}
+
+// Every index below length on the free stack exactly once, the end marker last
+static int free_stack_is_complete(void)
+{
+	uint8_t seen[benchPOOL_LENGTH];
+	uint32_t index = task_info_pool.free_head & poolINDEX_MASK;
+	uint32_t count = 0;
+
+	memset(seen, 0, sizeof(seen));
+
+	while(index < benchPOOL_LENGTH)
+	{
+		if(seen[index] || (++count > benchPOOL_LENGTH))
+		{
+			return 0;
+		}
+
+		seen[index] = 1;
+		index = task_info_pool.pnext_free[index];
+	}
+
+	return (index == benchPOOL_LENGTH) && (count == benchPOOL_LENGTH);
+}
+
+// The interleaving that defeats an untagged stack: a consumer reads head A
+// with next B, meanwhile A and B are popped and A is pushed back, so A is on
+// top again with a different next. The stale head must fail the compare.
+static int stale_head_is_rejected(void)
+{
+	uint32_t stale_head = __atomic_load_n(&(task_info_pool.free_head), __ATOMIC_ACQUIRE);
+	void *pfirst = pvDd_pool_alloc(&task_info_pool);
+	void *psecond = pvDd_pool_alloc(&task_info_pool);
+	int rejected;
+
+	dd_pool_free(&task_info_pool, pfirst);
+	rejected = ((task_info_pool.free_head & poolINDEX_MASK) == (stale_head & poolINDEX_MASK)) &&
+		(task_info_pool.free_head != stale_head);
+	dd_pool_free(&task_info_pool, psecond);
+
+	return rejected;
+}
+
+static void check_task(void *pvParameters)
+{
+	uint32_t worker_id;
+	uint32_t finished = 0;
+	size_t free_heap_before;
+	uint64_t start;
+	uint64_t elapsed;
+	char name[64];
+
+	(void) pvParameters;
+
+	dd_pool_init(&task_info_pool);
+	cycles_left = cycle_count;
+
+	for(worker_id = 0; worker_id < benchWORKERS; worker_id++)
+	{
+		xTaskCreate(worker_task, "Worker", configMINIMAL_STACK_SIZE * 2, (void *)(uintptr_t)worker_id, benchWORKER_PRIORITY, NULL);
+	}
+
+	free_heap_before = xPortGetFreeHeapSize();
+	start = bench_now_ns();
+
+	while(finished < benchWORKERS)
+	{
+		finished += ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+	}
+
+	elapsed = bench_now_ns() - start;
+
+	// Let the idle task free the deleted workers before the heap is compared
+	vTaskDelay(10);
+
+	printf("Pool: %u release/complete cycles by %d workers, %.0f ns per cycle\n", cycle_count, benchWORKERS,
+		(double)elapsed / (double)cycle_count);
+
+	snprintf(name, sizeof(name), "no descriptor handed out twice (%u foreign stamps)", foreign_stamps);
+	check(name, foreign_stamps == 0);
+	check("every descriptor inside the pool storage", stray_elements == 0);
+	check("no failed allocation", task_info_pool.alloc_failures == 0);
+	check("nothing in use at the end", task_info_pool.in_use == 0);
+	snprintf(name, sizeof(name), "high water mark within the pool (%u/%u)", task_info_pool.high_water_mark, task_info_pool.length);
+	check(name, task_info_pool.high_water_mark <= task_info_pool.length);
+	check("every descriptor back on the free stack once", free_stack_is_complete());
+	check("stale free head rejected after pop, pop, push", stale_head_is_rejected());
+	check("free stack still complete", free_stack_is_complete() && (task_info_pool.in_use == 0));
+	check("kernel heap unchanged", xPortGetFreeHeapSize() >= free_heap_before);
+
+	printf("Pool: %u checks failed\n", failed_checks);
+
+	exit((failed_checks == 0) ? 0 : 1);
+}
+
+int main(int argc, char **argv)
+{
+	if(argc > 1)
+	{
+		cycle_count = (uint32_t)strtoul(argv[1], NULL, 10);
+	}
+
+	if((cycle_count == 0) || (cycle_count > 0x7FFFFFFFUL))
+	{
+		fprintf(stderr, "usage: %s [cycles]\n", argv[0]);
+		return 2;
+	}
+
+	xTaskCreate(check_task, "Check", configMINIMAL_STACK_SIZE * 2, NULL, benchTASK_PRIORITY, &check_task_handle);
+	vTaskStartScheduler();
+
+	return 1;
+}
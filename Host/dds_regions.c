@@ -0,0 +1,206 @@
+/**
+  ******************************************************************************
+  * @file    dds_regions.c
+  * @brief   Host check of the heap_5 region selection (configUSE_HEAP_HINTS).
+  *
+  *          Two arrays stand in for the STM32F4 heap regions, one flagged
+  *          xCpuOnly like the CCM RAM and one DMA reachable like the SRAM,
+  *          and every pvPortMallocWithHint() hint is checked against them:
+  *
+  *          1.	portHEAP_HINT_DMA and portHEAP_HINT_ANY allocate in SRAM,
+  *				portHEAP_HINT_CPU in CCM.
+  *          2.	The kernel puts the TCB and stack of a task, a queue and a
+  *				timer in CCM.
+  *          3.	With CCM full portHEAP_HINT_CPU falls back to SRAM, with SRAM
+  *				full portHEAP_HINT_ANY falls back to CCM and
+  *				portHEAP_HINT_DMA fails rather than return CCM.
+  *          4.	Everything freed, the free heap size is back where it was.
+  *
+  *          Usage: dds_regions
+  *
+  *          Prints one line per check and exits with 1 if any failed.
+  ******************************************************************************
+  */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "timers.h"
+
+#define benchREGION_SIZE					( 32 * 1024 )
+#define benchBLOCK_SIZE						512
+#define benchMAX_BLOCKS						( ( 2 * benchREGION_SIZE ) / benchBLOCK_SIZE )
+#define benchTASK_PRIORITY					( configMAX_PRIORITIES - 1 )
+
+static uint8_t ccm_region[benchREGION_SIZE];
+static uint8_t sram_region[benchREGION_SIZE];
+
+static void *blocks[benchMAX_BLOCKS];
+static uint32_t failed_checks = 0;
+static uint32_t malloc_failed_count = 0;
+
+static int in_ccm(const void *pblock)
+{
+	return ((const uint8_t *)pblock >= ccm_region) && ((const uint8_t *)pblock < ccm_region + sizeof(ccm_region));
+}
+
+static int in_sram(const void *pblock)
+{
+	return ((const uint8_t *)pblock >= sram_region) && ((const uint8_t *)pblock < sram_region + sizeof(sram_region));
+}
+
+static void check(const char *pname, int passed)
+{
+	printf("Regions: %-56s %s\n", pname, passed ? "ok" : "FAILED");
+
+	if(!passed)
+	{
+		failed_checks++;
+	}
+}
+
+static void timer_callback(TimerHandle_t xTimer)
+{
+	(void) xTimer;
+}
+
+// Allocates with hint until a block lands outside the region in_first accepts
+// or the heap is exhausted, returns the number of blocks held in blocks[]
+static uint32_t fill_region(BaseType_t hint, int (*in_first)(const void *))
+{
+	uint32_t count = 0;
+	void *pblock;
+
+	while(count < benchMAX_BLOCKS)
+	{
+		pblock = pvPortMallocWithHint(benchBLOCK_SIZE, hint);
+
+		if(pblock == NULL)
+		{
+			break;
+		}
+
+		blocks[count++] = pblock;
+
+		if(!in_first(pblock))
+		{
+			break;
+		}
+	}
+
+	return count;
+}
+
+static void free_blocks(uint32_t count)
+{
+	while(count > 0)
+	{
+		vPortFree(blocks[--count]);
+	}
+}
+
+static void regions_task(void *pvParameters)
+{
+	TaskStatus_t task_status;
+	QueueHandle_t queue;
+	TimerHandle_t timer;
+	size_t free_before;
+	uint32_t count;
+	uint32_t failed_before;
+	void *pblock;
+
+	(void) pvParameters;
+
+	// 1. Each hint on an empty heap
+	free_before = xPortGetFreeHeapSize();
+
+	pblock = pvPortMallocWithHint(benchBLOCK_SIZE, portHEAP_HINT_DMA);
+	check("portHEAP_HINT_DMA allocates in SRAM", in_sram(pblock));
+	vPortFree(pblock);
+
+	pblock = pvPortMallocWithHint(benchBLOCK_SIZE, portHEAP_HINT_CPU);
+	check("portHEAP_HINT_CPU allocates in CCM", in_ccm(pblock));
+	vPortFree(pblock);
+
+	pblock = pvPortMalloc(benchBLOCK_SIZE);
+	check("pvPortMalloc() allocates in SRAM", in_sram(pblock));
+	vPortFree(pblock);
+
+	// 2. Kernel objects, this task was created before the checks began
+	vTaskGetInfo(NULL, &task_status, pdFALSE, eRunning);
+	check("task TCB in CCM", in_ccm(xTaskGetCurrentTaskHandle()));
+	check("task stack in CCM", in_ccm(task_status.pxStackBase));
+
+	queue = xQueueCreate(8, sizeof(uint32_t));
+	check("queue in CCM", in_ccm(queue));
+	vQueueDelete(queue);
+
+	timer = xTimerCreate("Regions", 1, pdFALSE, NULL, timer_callback);
+	check("timer in CCM", in_ccm(timer));
+	(void) xTimerDelete(timer, portMAX_DELAY);
+
+	// Let the timer task run the delete before the free heap size is compared
+	vTaskDelay(2);
+
+	// 3. Fallbacks
+	count = fill_region(portHEAP_HINT_CPU, in_ccm);
+	check("portHEAP_HINT_CPU falls back to SRAM when CCM is full", (count > 0) && in_sram(blocks[count - 1]));
+	free_blocks(count);
+
+	count = fill_region(portHEAP_HINT_ANY, in_sram);
+	check("portHEAP_HINT_ANY falls back to CCM when SRAM is full", (count > 0) && in_ccm(blocks[count - 1]));
+	free_blocks(count);
+
+	failed_before = malloc_failed_count;
+	count = fill_region(portHEAP_HINT_DMA, in_sram);
+	pblock = pvPortMallocWithHint(benchBLOCK_SIZE, portHEAP_HINT_DMA);
+	check("portHEAP_HINT_DMA fails when SRAM is full", (count > 0) && in_sram(blocks[count - 1]) && (pblock == NULL) &&
+		(malloc_failed_count > failed_before));
+	pblock = pvPortMallocWithHint(benchBLOCK_SIZE, portHEAP_HINT_CPU);
+	check("portHEAP_HINT_CPU still allocates in CCM", in_ccm(pblock));
+	vPortFree(pblock);
+	free_blocks(count);
+
+	// 4. Nothing leaked or lost between the regions
+	check("free heap size restored", xPortGetFreeHeapSize() == free_before);
+
+	printf("Regions: %u checks failed\n", failed_checks);
+
+	exit((failed_checks == 0) ? 0 : 1);
+}
+
+int main(void)
+{
+	HeapRegion_t heap_regions[3] =
+	{
+		{ ccm_region, sizeof(ccm_region), pdTRUE },
+		{ sram_region, sizeof(sram_region), pdFALSE },
+		{ NULL, 0, pdFALSE }
+	};
+	HeapRegion_t swap;
+
+	// heap_5 takes the regions in address order, which the linker picks here
+	if(heap_regions[0].pucStartAddress > heap_regions[1].pucStartAddress)
+	{
+		swap = heap_regions[0];
+		heap_regions[0] = heap_regions[1];
+		heap_regions[1] = swap;
+	}
+
+	vPortDefineHeapRegions(heap_regions);
+
+	xTaskCreate(regions_task, "Regions", configMINIMAL_STACK_SIZE * 2, NULL, benchTASK_PRIORITY, NULL);
+	vTaskStartScheduler();
+
+	return 1;
+}
+
+// Running out of a region is part of the checks, count it rather than stop
+void vApplicationMallocFailedHook(void)
+{
+	malloc_failed_count++;
+}
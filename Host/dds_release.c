@@ -0,0 +1,177 @@
+/**
+  ******************************************************************************
+  * @file    dds_release.c
+  * @brief   Host benchmark of the DD task release latency, a task created per
+  *          job against the pre-spawned DD worker pool.
+  *
+  *          A releaser at the DD scheduler's priority releases [rounds] jobs
+  *          at the execution priority and waits for each to report back. The
+  *          latency is timed from the start of the release until the first
+  *          instruction of the job function, both ways:
+  *
+  *          1.	create: xTaskCreate() a task for the job, which deletes
+  *				itself when done, as the DD task generators did before the
+  *				worker pool.
+  *          2.	worker: dd_worker_dispatch() from src/dd_worker.c, which the
+  *				DD scheduler runs, gives an idle worker the job's deadline and
+  *				the execution priority and hands it the job with
+  *				xTaskNotify(). Once the worker reports back the releaser frees
+  *				it with pDd_worker_release(), as the scheduler does on a
+  *				completion.
+  *
+  *          Every pvPortMalloc() is counted through -Wl,--wrap, so each way
+  *          also reports its heap allocations per release.
+  *
+  *          Usage: dds_release [rounds]
+  ******************************************************************************
+  */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "dd_task.h"
+#include "dd_worker.h"
+
+#include "bench.h"
+
+#define benchDEFAULT_ROUNDS					1000
+#define benchMAX_ROUNDS						100000
+#define benchLOWEST_PRIORITY				( tskIDLE_PRIORITY + 1 )
+#define benchEXECUTION_PRIORITY				( tskIDLE_PRIORITY + 3 )
+#define benchRELEASER_PRIORITY				( tskIDLE_PRIORITY + 5 )
+#define benchDEADLINE						1000
+
+static TaskHandle_t releaser_handle = NULL;
+static TaskHandle_t worker_handle = NULL;
+static uint32_t round_count = benchDEFAULT_ROUNDS;
+static volatile uint64_t release_start;
+static volatile uint32_t malloc_count = 0;
+
+static uint32_t create_ns[benchMAX_ROUNDS];
+static uint32_t worker_ns[benchMAX_ROUNDS];
+static bench_samples_t create_samples = { create_ns, benchMAX_ROUNDS, 0, 0 };
+static bench_samples_t worker_samples = { worker_ns, benchMAX_ROUNDS, 0, 0 };
+
+// The DD scheduler's worker pool, with one worker
+static TaskHandle_t idle_workers[1];
+static dd_task_info_t *pending_jobs[1];
+static dd_task_info_t job_infos[1];
+static dd_worker_pool_t worker_pool = { idle_workers, 1, 0, pending_jobs, 1, 0, job_infos, benchEXECUTION_PRIORITY, benchLOWEST_PRIORITY };
+
+void *__real_pvPortMalloc(size_t xWantedSize);
+
+void *__wrap_pvPortMalloc(size_t xWantedSize)
+{
+	malloc_count++;
+
+	return __real_pvPortMalloc(xWantedSize);
+}
+
+static void report_samples(const char *pname, bench_samples_t *psamples, uint32_t mallocs)
+{
+	bench_sort_samples(psamples);
+	printf("Release (%s): %5u jobs, min %6u ns, mean %6.0f ns, p99 %6u ns, max %7u ns, %.1f allocations per release\n", pname,
+		psamples->count, bench_sample_percentile(psamples, 0), bench_sample_mean(psamples), bench_sample_percentile(psamples, 99),
+		bench_sample_percentile(psamples, 100), (double)mallocs / (double)psamples->count);
+}
+
+// The job, its first instruction ends the release
+static void job_function(void *pvParameters)
+{
+	bench_add_sample((bench_samples_t *)pvParameters, bench_now_ns() - release_start);
+}
+
+static void created_job_task(void *pvParameters)
+{
+	job_function(pvParameters);
+
+	xTaskNotifyGive(releaser_handle);
+	vTaskDelete(NULL);
+}
+
+// Runs the job it is handed, as the DD workers of src/main.c do
+static void worker_task(void *pvParameters)
+{
+	uint32_t job_index;
+
+	(void) pvParameters;
+
+	while(1)
+	{
+		if((xTaskNotifyWait(0, 0xFFFFFFFFUL, &job_index, portMAX_DELAY) == pdTRUE) && (job_index < 1))
+		{
+			job_infos[job_index].job_function((void *)&worker_samples);
+
+			xTaskNotifyGive(releaser_handle);
+		}
+	}
+}
+
+static void releaser_task(void *pvParameters)
+{
+	uint32_t round;
+	uint32_t mallocs;
+
+	(void) pvParameters;
+
+	// 1. A task per job
+	mallocs = malloc_count;
+
+	for(round = 0; round < round_count; round++)
+	{
+		// Let the idle task free the previous job's task first
+		vTaskDelay(1);
+
+		release_start = bench_now_ns();
+		xTaskCreate(created_job_task, "Job", configMINIMAL_STACK_SIZE, (void *)&create_samples, benchEXECUTION_PRIORITY, NULL);
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+	}
+
+	report_samples("create", &create_samples, malloc_count - mallocs);
+
+	// 2. The pre-spawned worker
+	xTaskCreate(worker_task, "Worker", configMINIMAL_STACK_SIZE, NULL, benchLOWEST_PRIORITY, &worker_handle);
+	dd_worker_add_idle(&worker_pool, worker_handle);
+	job_infos[0].job_function = job_function;
+	job_infos[0].state = TASK_ACTIVE;
+	vTaskDelay(1);
+	mallocs = malloc_count;
+
+	for(round = 0; round < round_count; round++)
+	{
+		vTaskDelay(1);
+		job_infos[0].absolute_deadline = xTaskGetTickCount() + benchDEADLINE;
+
+		release_start = bench_now_ns();
+		(void) dd_worker_dispatch(&worker_pool, &job_infos[0]);
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		(void) pDd_worker_release(&worker_pool, worker_handle);
+	}
+
+	report_samples("worker", &worker_samples, malloc_count - mallocs);
+
+	exit(0);
+}
+
+int main(int argc, char **argv)
+{
+	if(argc > 1)
+	{
+		round_count = (uint32_t)strtoul(argv[1], NULL, 10);
+	}
+
+	if((round_count == 0) || (round_count > benchMAX_ROUNDS))
+	{
+		fprintf(stderr, "usage: %s [rounds 1..%d]\n", argv[0], benchMAX_ROUNDS);
+		return 2;
+	}
+
+	xTaskCreate(releaser_task, "Releaser", configMINIMAL_STACK_SIZE * 2, NULL, benchRELEASER_PRIORITY, &releaser_handle);
+	vTaskStartScheduler();
+
+	return 1;
+}
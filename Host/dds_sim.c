@@ -0,0 +1,772 @@
+/**
+  ******************************************************************************
+  * @file    dds_sim.c
+  * @brief   Discrete-event EDF simulator for DD task sets.
+  *
+  *          Replays a task set on one virtual processor with the policy of
+  *          the DD scheduler in src/main.c: active jobs run earliest deadline
+  *          first, and a job whose deadline passes is handled by the overrun
+  *          policy (dd_overrun_policy_t):
+  *            continue  it moves to the overdue list and keeps running in
+  *                      the background when no active job is ready
+  *            abort     it is dropped at once, its remaining work is never run
+  *            skip      as continue, and the next release of its periodic
+  *                      task is skipped
+  *          A skipped release counts as a missed job in the miss ratio.
+  *
+  *          Like on the target a job only runs on one of simWORKERS workers,
+  *          handed out in release order. When the earliest deadline job
+  *          still waits for a worker, the jobs holding one run instead,
+  *          active before overdue. Overdue jobs that never get the processor
+  *          therefore keep their workers from the jobs released after them.
+  *          Time only advances from event to event (release, completion,
+  *          deadline), so N hyper periods take milliseconds instead of
+  *          N * HYPER_PERIOD ticks of wall-clock time.
+  *
+  *          Usage: dds_sim <task set file> [hyper periods] [continue|abort|skip]
+  *
+  *          Task set file, one task per line, '#' starts a comment:
+  *            periodic  <id> <period>  <wcet> [relative deadline]
+  *            aperiodic <id> <release> <wcet> <relative deadline>
+  *          The period of a periodic task is also its deadline by default.
+  *          Aperiodic releases are offsets into the hyper period (the LCM of
+  *          the periods) and arrive again in every hyper period.
+  *
+  *          Idle time is also replayed against the target's tickless idle:
+  *          an idle processor sleeps until the next release, at most
+  *          simMAX_SUPPRESSED_TICKS ticks per sleep, and every sleep ends
+  *          with one tick interrupt.
+  ******************************************************************************
+  */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <time.h>
+
+#include "dd_task.h"
+
+#define simMAX_TASKS						32
+#define simJOB_POOL_LENGTH					65536
+#define simHISTOGRAM_BUCKETS				20
+#define simHISTOGRAM_BAR_LENGTH				40
+#define simDEFAULT_HYPER_PERIODS			1000
+#define simMAX_HYPER_PERIOD					(1ULL << 40)
+#define simLINE_LENGTH						256
+#define simWORKERS							4					// workerPOOL_LENGTH in src/main.c
+#define simNO_WORKER						UINT32_MAX
+
+// Longest tickless sleep on the target, the 24-bit SysTick reload holds
+// 0xFFFFFF / (168 MHz / 1000 Hz) = 99 tick periods
+#define simMAX_SUPPRESSED_TICKS				99
+
+typedef struct sim_task
+{
+	task_type_t type;
+	uint32_t task_id;
+	uint64_t period;
+	uint64_t wcet;
+	uint64_t relative_deadline;
+	uint64_t next_release;
+	uint64_t bucket_width;
+	uint64_t released;
+	uint64_t completed;
+	uint64_t missed;
+	uint64_t dropped;
+	uint64_t aborted;
+	uint64_t skipped;
+	bool skip_next;
+	uint64_t response_min;
+	uint64_t response_max;
+	uint64_t response_total;
+	// Buckets of bucket_width ticks cover [0, 2 * relative_deadline), the last one counts everything later
+	uint64_t histogram[simHISTOGRAM_BUCKETS + 1];
+} sim_task_t;
+
+// One released job. info comes first so entries of the active heap convert
+// straight back to their job, node links the job into the overdue list.
+typedef struct sim_job
+{
+	dd_task_info_t info;
+	dd_task_node_t node;
+	sim_task_t *ptask;
+	uint64_t release_time;
+	uint64_t absolute_deadline;
+	uint64_t remaining;
+	uint32_t worker;
+	struct sim_job *pnext_free;
+	struct sim_job *pnext_waiting;
+} sim_job_t;
+
+static sim_task_t sim_tasks[simMAX_TASKS];
+static uint32_t sim_task_count = 0;
+
+static sim_job_t sim_job_pool[simJOB_POOL_LENGTH];
+static sim_job_t *psim_free_jobs = NULL;
+
+static dd_task_info_t *pSim_active_heap[simJOB_POOL_LENGTH];
+static dd_task_heap_t sim_active_heap = { pSim_active_heap, 0, simJOB_POOL_LENGTH };
+
+// Overdue jobs run oldest first, the list is unbounded since every node lives in its job
+static dd_task_list_t sim_overdue_list = { NULL, NULL, 0, simJOB_POOL_LENGTH };
+
+static dd_overrun_policy_t sim_overrun_policy = OVERRUN_CONTINUE;
+static const char *const overrun_policy_names[] = { "continue", "abort", "skip" };
+
+// Job each worker holds, and the jobs waiting for a worker in release order
+static sim_job_t *psim_worker_jobs[simWORKERS];
+static sim_job_t *psim_waiting_head = NULL;
+static sim_job_t *psim_waiting_tail = NULL;
+
+static uint64_t sim_event_count = 0;
+static uint64_t sim_idle_ticks = 0;
+static uint64_t sim_tickless_wakeups = 0;
+
+static void sim_job_pool_init(void)
+{
+	uint32_t index;
+
+	for(index = 0; index < simJOB_POOL_LENGTH; index++)
+	{
+		sim_job_pool[index].pnext_free = (index + 1 < simJOB_POOL_LENGTH) ? &sim_job_pool[index + 1] : NULL;
+	}
+
+	psim_free_jobs = &sim_job_pool[0];
+}
+
+static uint64_t gcd(uint64_t first, uint64_t second)
+{
+	uint64_t remainder;
+
+	while(second != 0)
+	{
+		remainder = first % second;
+		first = second;
+		second = remainder;
+	}
+
+	return first;
+}
+
+// Parse the task set file, returns 0 on success
+static int load_task_set(const char *pfile_name)
+{
+	FILE *pfile;
+	char line[simLINE_LENGTH];
+	char type_name[16];
+	unsigned long long values[4];
+	uint32_t line_number = 0;
+	sim_task_t *ptask;
+	int fields;
+	char *pcomment;
+
+	pfile = fopen(pfile_name, "r");
+
+	if(pfile == NULL)
+	{
+		fprintf(stderr, "dds_sim: cannot open %s\n", pfile_name);
+		return -1;
+	}
+
+	while(fgets(line, sizeof(line), pfile) != NULL)
+	{
+		line_number++;
+
+		if((pcomment = strchr(line, '#')) != NULL)
+		{
+			*pcomment = '\0';
+		}
+
+		fields = sscanf(line, "%15s %llu %llu %llu %llu", type_name, &values[0], &values[1], &values[2], &values[3]);
+
+		if(fields <= 0)
+		{
+			continue;
+		}
+
+		if(sim_task_count >= simMAX_TASKS)
+		{
+			fprintf(stderr, "dds_sim: %s:%u: more than %d tasks\n", pfile_name, line_number, simMAX_TASKS);
+			fclose(pfile);
+			return -1;
+		}
+
+		ptask = &sim_tasks[sim_task_count];
+		memset(ptask, 0, sizeof(sim_task_t));
+
+		if((strcmp(type_name, "periodic") == 0) && (fields >= 4))
+		{
+			ptask->type = PERIODIC;
+			ptask->period = values[1];
+			ptask->next_release = 0;
+			ptask->relative_deadline = (fields == 5) ? values[3] : values[1];
+		}
+		else if((strcmp(type_name, "aperiodic") == 0) && (fields == 5))
+		{
+			ptask->type = APERIODIC;
+			ptask->next_release = values[1];
+			ptask->relative_deadline = values[3];
+		}
+		else
+		{
+			fprintf(stderr, "dds_sim: %s:%u: expected 'periodic <id> <period> <wcet> [deadline]' or 'aperiodic <id> <release> <wcet> <deadline>'\n", pfile_name, line_number);
+			fclose(pfile);
+			return -1;
+		}
+
+		ptask->task_id = (uint32_t)values[0];
+		ptask->wcet = values[2];
+
+		if((ptask->wcet == 0) || (ptask->relative_deadline == 0) || (ptask->relative_deadline > INT32_MAX) || ((ptask->type == PERIODIC) && (ptask->period == 0)))
+		{
+			fprintf(stderr, "dds_sim: %s:%u: period, wcet and deadline must be positive\n", pfile_name, line_number);
+			fclose(pfile);
+			return -1;
+		}
+
+		ptask->bucket_width = ((2 * ptask->relative_deadline) + simHISTOGRAM_BUCKETS - 1) / simHISTOGRAM_BUCKETS;
+		ptask->response_min = UINT64_MAX;
+		sim_task_count++;
+	}
+
+	fclose(pfile);
+
+	if(sim_task_count == 0)
+	{
+		fprintf(stderr, "dds_sim: %s: no tasks\n", pfile_name);
+		return -1;
+	}
+
+	return 0;
+}
+
+// The hyper period is the LCM of the periods, aperiodic arrivals must fall inside it
+static uint64_t hyper_period_of_task_set(void)
+{
+	uint64_t hyper_period = 1;
+	uint64_t last_arrival = 0;
+	uint32_t index;
+
+	for(index = 0; index < sim_task_count; index++)
+	{
+		if(sim_tasks[index].type == PERIODIC)
+		{
+			hyper_period = (hyper_period / gcd(hyper_period, sim_tasks[index].period)) * sim_tasks[index].period;
+
+			if(hyper_period > simMAX_HYPER_PERIOD)
+			{
+				return 0;
+			}
+		}
+		else if(sim_tasks[index].next_release >= last_arrival)
+		{
+			last_arrival = sim_tasks[index].next_release + 1;
+		}
+	}
+
+	if(hyper_period < last_arrival)
+	{
+		hyper_period = last_arrival;
+	}
+
+	// Aperiodic arrivals repeat once per hyper period
+	for(index = 0; index < sim_task_count; index++)
+	{
+		if(sim_tasks[index].type == APERIODIC)
+		{
+			sim_tasks[index].period = hyper_period;
+		}
+	}
+
+	return hyper_period;
+}
+
+static uint64_t earliest_release_time(void)
+{
+	uint64_t earliest = UINT64_MAX;
+	uint32_t index;
+
+	for(index = 0; index < sim_task_count; index++)
+	{
+		if(sim_tasks[index].next_release < earliest)
+		{
+			earliest = sim_tasks[index].next_release;
+		}
+	}
+
+	return earliest;
+}
+
+// Hand a released job a free worker or queue it, as dispatch_dd_task_to_worker does
+static void assign_worker(sim_job_t *pjob)
+{
+	uint32_t worker;
+
+	for(worker = 0; worker < simWORKERS; worker++)
+	{
+		if(psim_worker_jobs[worker] == NULL)
+		{
+			psim_worker_jobs[worker] = pjob;
+			pjob->worker = worker;
+			return;
+		}
+	}
+
+	pjob->worker = simNO_WORKER;
+	pjob->pnext_waiting = NULL;
+
+	if(psim_waiting_tail == NULL)
+	{
+		psim_waiting_head = pjob;
+	}
+	else
+	{
+		psim_waiting_tail->pnext_waiting = pjob;
+	}
+
+	psim_waiting_tail = pjob;
+}
+
+// Give the worker of a finished job to the oldest waiting job, or take a job
+// that never got a worker off the waiting queue
+static void release_worker(sim_job_t *pjob)
+{
+	sim_job_t *pprevious = NULL;
+	sim_job_t *pwaiting = psim_waiting_head;
+	sim_job_t *pnext;
+
+	if(pjob->worker != simNO_WORKER)
+	{
+		pnext = psim_waiting_head;
+		psim_worker_jobs[pjob->worker] = pnext;
+
+		if(pnext != NULL)
+		{
+			pnext->worker = pjob->worker;
+			psim_waiting_head = pnext->pnext_waiting;
+
+			if(psim_waiting_head == NULL)
+			{
+				psim_waiting_tail = NULL;
+			}
+		}
+
+		return;
+	}
+
+	while((pwaiting != NULL) && (pwaiting != pjob))
+	{
+		pprevious = pwaiting;
+		pwaiting = pwaiting->pnext_waiting;
+	}
+
+	if(pwaiting == NULL)
+	{
+		return;
+	}
+
+	if(pprevious == NULL)
+	{
+		psim_waiting_head = pjob->pnext_waiting;
+	}
+	else
+	{
+		pprevious->pnext_waiting = pjob->pnext_waiting;
+	}
+
+	if(psim_waiting_tail == pjob)
+	{
+		psim_waiting_tail = pprevious;
+	}
+}
+
+static void release_job(sim_task_t *ptask, uint64_t current_time)
+{
+	sim_job_t *pjob = psim_free_jobs;
+
+	sim_event_count++;
+	ptask->released++;
+
+	if(pjob == NULL)
+	{
+		ptask->dropped++;
+		return;
+	}
+
+	psim_free_jobs = pjob->pnext_free;
+	memset(&pjob->info, 0, sizeof(dd_task_info_t));
+	pjob->info.type = ptask->type;
+	pjob->info.state = TASK_ACTIVE;
+	pjob->info.job_outstanding = true;
+	pjob->info.task_id = ptask->task_id;
+	pjob->info.release_time = (uint32_t)current_time;
+	pjob->info.absolute_deadline = (uint32_t)(current_time + ptask->relative_deadline);
+	pjob->info.heap_index = heapINDEX_NONE;
+	pjob->node.pnode = &pjob->info;
+	pjob->node.pnext_node = NULL;
+	pjob->ptask = ptask;
+	pjob->release_time = current_time;
+	pjob->absolute_deadline = current_time + ptask->relative_deadline;
+	pjob->remaining = ptask->wcet;
+
+	dd_heap_insert(&sim_active_heap, &pjob->info);
+	assign_worker(pjob);
+}
+
+// Unlink a finished overdue job, it is not always the oldest one when workers are short
+static void remove_overdue_job(sim_job_t *pjob)
+{
+	dd_task_node_t *pprevious = NULL;
+	dd_task_node_t *pnode = sim_overdue_list.phead;
+
+	while((pnode != NULL) && (pnode != &pjob->node))
+	{
+		pprevious = pnode;
+		pnode = pnode->pnext_node;
+	}
+
+	if(pnode == NULL)
+	{
+		return;
+	}
+
+	if(pprevious == NULL)
+	{
+		sim_overdue_list.phead = pnode->pnext_node;
+	}
+	else
+	{
+		pprevious->pnext_node = pnode->pnext_node;
+	}
+
+	if(sim_overdue_list.ptail == pnode)
+	{
+		sim_overdue_list.ptail = pprevious;
+	}
+
+	sim_overdue_list.length--;
+}
+
+static void complete_job(sim_job_t *pjob, uint64_t current_time)
+{
+	sim_task_t *ptask = pjob->ptask;
+	uint64_t response_time = current_time - pjob->release_time;
+	uint64_t bucket = response_time / ptask->bucket_width;
+
+	sim_event_count++;
+	pjob->info.completion_time = (uint32_t)current_time;
+	pjob->info.job_outstanding = false;
+
+	if(pjob->info.state == TASK_ACTIVE)
+	{
+		pjob->info.state = TASK_COMPLETED;
+		pDd_heap_remove(&sim_active_heap, pjob->info.heap_index);
+	}
+	else
+	{
+		remove_overdue_job(pjob);
+	}
+
+	release_worker(pjob);
+
+	ptask->completed++;
+	ptask->response_total += response_time;
+
+	if(response_time < ptask->response_min)
+	{
+		ptask->response_min = response_time;
+	}
+
+	if(response_time > ptask->response_max)
+	{
+		ptask->response_max = response_time;
+	}
+
+	ptask->histogram[(bucket < simHISTOGRAM_BUCKETS) ? bucket : simHISTOGRAM_BUCKETS]++;
+
+	pjob->pnext_free = psim_free_jobs;
+	psim_free_jobs = pjob;
+}
+
+// Apply the overrun policy to the earliest deadline job: free an aborted job,
+// otherwise move it to the tail of the overdue list
+static void overdue_job(sim_job_t *pjob, uint64_t current_time)
+{
+	sim_event_count++;
+	pDd_heap_remove(&sim_active_heap, 0);
+	pjob->info.state = TASK_OVERDUE;
+	pjob->info.overdue_time = (uint32_t)current_time;
+	pjob->ptask->missed++;
+
+	if(sim_overrun_policy == OVERRUN_ABORT)
+	{
+		pjob->ptask->aborted++;
+		release_worker(pjob);
+		pjob->pnext_free = psim_free_jobs;
+		psim_free_jobs = pjob;
+		return;
+	}
+
+	if((sim_overrun_policy == OVERRUN_SKIP_NEXT) && (pjob->ptask->type == PERIODIC))
+	{
+		pjob->ptask->skip_next = true;
+	}
+
+	if(sim_overdue_list.ptail == NULL)
+	{
+		sim_overdue_list.phead = &pjob->node;
+	}
+	else
+	{
+		sim_overdue_list.ptail->pnext_node = &pjob->node;
+	}
+
+	sim_overdue_list.ptail = &pjob->node;
+	sim_overdue_list.length++;
+}
+
+// The earliest deadline active job runs once it holds a worker. Until then, and
+// when no job is active, the jobs holding a worker run: active ones by
+// deadline, then overdue ones oldest first.
+static sim_job_t *pRunning_job(void)
+{
+	sim_job_t *pearliest = (sim_job_t *)pDd_heap_peek(&sim_active_heap);
+	sim_job_t *pbest = NULL;
+	sim_job_t *pjob;
+	uint32_t worker;
+
+	if((pearliest != NULL) && (pearliest->worker != simNO_WORKER))
+	{
+		return pearliest;
+	}
+
+	for(worker = 0; worker < simWORKERS; worker++)
+	{
+		pjob = psim_worker_jobs[worker];
+
+		if(pjob == NULL)
+		{
+			continue;
+		}
+
+		if((pbest == NULL) ||
+			((pjob->info.state == TASK_ACTIVE) && ((pbest->info.state != TASK_ACTIVE) || (pjob->absolute_deadline < pbest->absolute_deadline))) ||
+			((pjob->info.state != TASK_ACTIVE) && (pbest->info.state != TASK_ACTIVE) && (pjob->info.overdue_time < pbest->info.overdue_time)))
+		{
+			pbest = pjob;
+		}
+	}
+
+	return pbest;
+}
+
+// Run until end_time, then stop releasing and drain every outstanding job
+static void simulate(uint64_t end_time)
+{
+	uint64_t current_time = 0;
+	uint64_t next_release = earliest_release_time();
+	uint64_t next_time;
+	sim_job_t *prunning;
+	sim_job_t *pearliest;
+	uint32_t index;
+
+	while(1)
+	{
+		prunning = pRunning_job();
+		pearliest = (sim_job_t *)pDd_heap_peek(&sim_active_heap);
+		next_time = (next_release < end_time) ? next_release : UINT64_MAX;
+
+		if((prunning != NULL) && (current_time + prunning->remaining < next_time))
+		{
+			next_time = current_time + prunning->remaining;
+		}
+
+		if((pearliest != NULL) && (pearliest->absolute_deadline < next_time))
+		{
+			next_time = pearliest->absolute_deadline;
+		}
+
+		if(next_time == UINT64_MAX)
+		{
+			break;
+		}
+
+		if(prunning != NULL)
+		{
+			prunning->remaining -= next_time - current_time;
+		}
+		else
+		{
+			// Nothing is ready and no deadline is pending, sleep until the next release
+			sim_idle_ticks += next_time - current_time;
+			sim_tickless_wakeups += (next_time - current_time + simMAX_SUPPRESSED_TICKS - 1) / simMAX_SUPPRESSED_TICKS;
+		}
+
+		current_time = next_time;
+
+		// A job that finishes on its deadline tick has met it
+		if((prunning != NULL) && (prunning->remaining == 0))
+		{
+			complete_job(prunning, current_time);
+		}
+
+		while(((pearliest = (sim_job_t *)pDd_heap_peek(&sim_active_heap)) != NULL) && (pearliest->absolute_deadline <= current_time))
+		{
+			overdue_job(pearliest, current_time);
+		}
+
+		if((next_release <= current_time) && (next_release < end_time))
+		{
+			for(index = 0; index < sim_task_count; index++)
+			{
+				if((sim_tasks[index].next_release <= current_time) && (sim_tasks[index].next_release < end_time))
+				{
+					if(sim_tasks[index].skip_next)
+					{
+						sim_tasks[index].skip_next = false;
+						sim_tasks[index].skipped++;
+					}
+					else
+					{
+						release_job(&sim_tasks[index], current_time);
+					}
+
+					sim_tasks[index].next_release += sim_tasks[index].period;
+				}
+			}
+
+			next_release = earliest_release_time();
+		}
+	}
+}
+
+static void print_task_statistics(sim_task_t *ptask)
+{
+	uint64_t largest_bucket = 1;
+	uint64_t bucket_start;
+	uint32_t bucket;
+	uint32_t bar_length;
+
+	printf("Task %u (%s): period = %" PRIu64 ", wcet = %" PRIu64 ", deadline = %" PRIu64 "\n", ptask->task_id, (ptask->type == PERIODIC) ? "periodic" : "aperiodic", ptask->period, ptask->wcet, ptask->relative_deadline);
+	printf("  released = %" PRIu64 ", completed = %" PRIu64 ", missed = %" PRIu64 ", dropped = %" PRIu64 ", aborted = %" PRIu64 ", skipped = %" PRIu64 "\n",
+		ptask->released, ptask->completed, ptask->missed, ptask->dropped, ptask->aborted, ptask->skipped);
+	printf("  miss ratio = %.4f\n", (double)(ptask->missed + ptask->dropped + ptask->skipped) / (double)(ptask->released + ptask->skipped));
+
+	if(ptask->completed == 0)
+	{
+		return;
+	}
+
+	printf("  response time: min = %" PRIu64 ", mean = %.1f, max = %" PRIu64 "\n", ptask->response_min, (double)ptask->response_total / (double)ptask->completed, ptask->response_max);
+
+	for(bucket = 0; bucket <= simHISTOGRAM_BUCKETS; bucket++)
+	{
+		if(ptask->histogram[bucket] > largest_bucket)
+		{
+			largest_bucket = ptask->histogram[bucket];
+		}
+	}
+
+	for(bucket = 0; bucket <= simHISTOGRAM_BUCKETS; bucket++)
+	{
+		bucket_start = bucket * ptask->bucket_width;
+		bar_length = (uint32_t)((ptask->histogram[bucket] * simHISTOGRAM_BAR_LENGTH + largest_bucket - 1) / largest_bucket);
+
+		if(bucket < simHISTOGRAM_BUCKETS)
+		{
+			printf("  [%8" PRIu64 ", %8" PRIu64 ") %12" PRIu64 "%.*s\n", bucket_start, bucket_start + ptask->bucket_width, ptask->histogram[bucket], (int)((bar_length > 0) ? (bar_length + 1) : 0), " ########################################");
+		}
+		else
+		{
+			printf("  [%8" PRIu64 ",      inf) %12" PRIu64 "%.*s\n", bucket_start, ptask->histogram[bucket], (int)((bar_length > 0) ? (bar_length + 1) : 0), " ########################################");
+		}
+	}
+}
+
+int main(int argc, char **argv)
+{
+	uint64_t hyper_periods = simDEFAULT_HYPER_PERIODS;
+	uint64_t hyper_period;
+	double utilization = 0.0;
+	double elapsed;
+	struct timespec start;
+	struct timespec end;
+	uint64_t jobs = 0;
+	uint64_t missed_jobs = 0;
+	uint32_t index;
+
+	if((argc < 2) || (argc > 4))
+	{
+		fprintf(stderr, "usage: %s <task set file> [hyper periods] [continue|abort|skip]\n", argv[0]);
+		return 2;
+	}
+
+	if(argc >= 3)
+	{
+		hyper_periods = strtoull(argv[2], NULL, 0);
+	}
+
+	if(argc == 4)
+	{
+		for(index = 0; index <= OVERRUN_SKIP_NEXT; index++)
+		{
+			if(strcmp(argv[3], overrun_policy_names[index]) == 0)
+			{
+				sim_overrun_policy = (dd_overrun_policy_t)index;
+				break;
+			}
+		}
+
+		if(index > OVERRUN_SKIP_NEXT)
+		{
+			fprintf(stderr, "dds_sim: overrun policy must be continue, abort or skip\n");
+			return 2;
+		}
+	}
+
+	if((hyper_periods == 0) || (load_task_set(argv[1]) != 0))
+	{
+		return 2;
+	}
+
+	hyper_period = hyper_period_of_task_set();
+
+	if((hyper_period == 0) || (hyper_periods > (UINT64_MAX / 2) / hyper_period))
+	{
+		fprintf(stderr, "dds_sim: hyper period is too long to simulate\n");
+		return 2;
+	}
+
+	for(index = 0; index < sim_task_count; index++)
+	{
+		utilization += (double)sim_tasks[index].wcet / (double)sim_tasks[index].period;
+	}
+
+	printf("Task set %s: %u tasks, utilization = %.3f, hyper period = %" PRIu64 ", simulating %" PRIu64 " hyper periods, overrun policy = %s\n",
+		argv[1], sim_task_count, utilization, hyper_period, hyper_periods, overrun_policy_names[sim_overrun_policy]);
+
+	sim_job_pool_init();
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	simulate(hyper_period * hyper_periods);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	elapsed = (double)(end.tv_sec - start.tv_sec) + ((double)(end.tv_nsec - start.tv_nsec) / 1e9);
+
+	for(index = 0; index < sim_task_count; index++)
+	{
+		print_task_statistics(&sim_tasks[index]);
+		jobs += sim_tasks[index].released + sim_tasks[index].skipped;
+		missed_jobs += sim_tasks[index].missed + sim_tasks[index].dropped + sim_tasks[index].skipped;
+	}
+
+	printf("Overrun policy %s: %" PRIu64 " of %" PRIu64 " jobs missed their deadline, miss ratio = %.4f\n",
+		overrun_policy_names[sim_overrun_policy], missed_jobs, jobs, (double)missed_jobs / (double)jobs);
+
+	printf("Tickless idle per hyper period: idle ticks = %.1f, ticks suppressed = %.1f, wakeups = %.1f (%.1f tick interrupts instead of %" PRIu64 ")\n",
+		(double)sim_idle_ticks / (double)hyper_periods, (double)(sim_idle_ticks - sim_tickless_wakeups) / (double)hyper_periods,
+		(double)sim_tickless_wakeups / (double)hyper_periods, (double)hyper_period - ((double)(sim_idle_ticks - sim_tickless_wakeups) / (double)hyper_periods), hyper_period);
+	printf("%" PRIu64 " events in %.3f s (%.0f events/s)\n", sim_event_count, elapsed, (elapsed > 0.0) ? ((double)sim_event_count / elapsed) : 0.0);
+
+	return 0;
+}
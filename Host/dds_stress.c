@@ -0,0 +1,259 @@
+/**
+  ******************************************************************************
+  * @file    dds_stress.c
+  * @brief   Host stress test of the DD active task heap (src/dd_task.c) with
+  *          thousands of concurrently active DD tasks.
+  *
+  *          A task fills the heap with [active] DD tasks and then runs
+  *          [operations] random scheduler operations on it, keeping between
+  *          half and all of them active: a release inserts an idle task, a
+  *          completion removes a random active one through its heap index and
+  *          an overdue removes the earliest. Deadlines are drawn from a
+  *          window of benchDEADLINE_SPREAD ticks, so most tasks share their
+  *          deadline with others, and the tick starts just before the 32-bit
+  *          counter wraps.
+  *
+  *          Every operation checks the task it removed: the one asked for,
+  *          out of the heap and no longer removable. Every
+  *          benchVERIFY_INTERVAL operations and at the end the whole heap is
+  *          checked: the heap order, every heap_index pointing back at its
+  *          own entry and exactly the tasks the test holds active in it.
+  *
+  *          Usage: dds_stress [operations] [active]
+  *
+  *          Prints the operation counts and cost and exits with 1 if any
+  *          check failed.
+  ******************************************************************************
+  */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "dd_task.h"
+
+#include "bench.h"
+
+#define benchMAX_ACTIVE						16384
+#define benchDEFAULT_ACTIVE					4096
+#define benchDEFAULT_OPERATIONS				1000000
+#define benchDEADLINE_SPREAD				64
+#define benchVERIFY_INTERVAL				4096
+#define benchSTART_TIME						0xFFFF0000UL
+#define benchTASK_PRIORITY					( configMAX_PRIORITIES - 1 )
+
+static dd_task_info_t task_infos[benchMAX_ACTIVE];
+static bool task_active[benchMAX_ACTIVE];
+// Task infos outside the heap wait on a stack for their next release
+static dd_task_info_t *idle_task_infos[benchMAX_ACTIVE];
+static uint32_t idle_count = 0;
+static dd_task_info_t *heap_entries[benchMAX_ACTIVE];
+static dd_task_heap_t active_heap = { heap_entries, 0, benchMAX_ACTIVE };
+
+static uint32_t operation_count = benchDEFAULT_OPERATIONS;
+static uint32_t active_count = benchDEFAULT_ACTIVE;
+static uint32_t current_time = benchSTART_TIME;
+static uint32_t failed_checks = 0;
+
+static uint32_t release_count = 0;
+static uint32_t complete_count = 0;
+static uint32_t overdue_count = 0;
+static uint32_t verify_count = 0;
+
+static uint64_t random_state = benchRANDOM_SEED;
+
+static void check(const char *pname, bool passed)
+{
+	if(!passed)
+	{
+		// Only the first few, a broken heap fails on every operation after
+		if(failed_checks < 10)
+		{
+			printf("Stress: %s FAILED after %u operations\n", pname, release_count + complete_count + overdue_count);
+		}
+
+		failed_checks++;
+	}
+}
+
+static void release_task(void)
+{
+	dd_task_info_t *ptask_info = idle_task_infos[--idle_count];
+
+	current_time++;
+	ptask_info->absolute_deadline = current_time + 1 + (bench_random_next(&random_state) % benchDEADLINE_SPREAD);
+
+	check("release inserted", dd_heap_insert(&active_heap, ptask_info));
+	check("released task indexed", (ptask_info->heap_index < active_heap.length) &&
+		(active_heap.pentries[ptask_info->heap_index] == ptask_info));
+
+	task_active[ptask_info->task_id] = true;
+	release_count++;
+}
+
+static void retire_task(dd_task_info_t *ptask_info)
+{
+	check("removed task out of the heap", ptask_info->heap_index == heapINDEX_NONE);
+	check("removed task not removable again", !dd_heap_remove_task(&active_heap, ptask_info));
+
+	task_active[ptask_info->task_id] = false;
+	idle_task_infos[idle_count++] = ptask_info;
+}
+
+// A completion names its task, which may share its deadline with many others
+static void complete_task(void)
+{
+	dd_task_info_t *ptask_info = active_heap.pentries[bench_random_next(&random_state) % active_heap.length];
+
+	check("completed task removed", dd_heap_remove_task(&active_heap, ptask_info));
+	retire_task(ptask_info);
+	complete_count++;
+}
+
+static void expire_earliest_task(void)
+{
+	dd_task_info_t *pearliest = pDd_heap_peek(&active_heap);
+	dd_task_info_t *ptask_info = pDd_heap_remove(&active_heap, 0);
+	dd_task_info_t *pnext = pDd_heap_peek(&active_heap);
+
+	check("overdue task is the earliest", (ptask_info != NULL) && (ptask_info == pearliest));
+	check("no earlier task left", (ptask_info == NULL) || (pnext == NULL) || !deadline_is_earlier(pnext, ptask_info));
+
+	if(ptask_info != NULL)
+	{
+		retire_task(ptask_info);
+	}
+
+	overdue_count++;
+}
+
+static void verify_heap(void)
+{
+	uint32_t index;
+	uint32_t in_heap = 0;
+	bool ordered = true;
+	bool indexed = true;
+	bool members = true;
+
+	for(index = 0; index < active_heap.length; index++)
+	{
+		if(active_heap.pentries[index]->heap_index != index)
+		{
+			indexed = false;
+		}
+
+		if((index > 0) && deadline_is_earlier(active_heap.pentries[index], active_heap.pentries[(index - 1) / 2]))
+		{
+			ordered = false;
+		}
+	}
+
+	for(index = 0; index < active_count; index++)
+	{
+		if(task_active[index])
+		{
+			in_heap++;
+			members = members && (task_infos[index].heap_index < active_heap.length) &&
+				(active_heap.pentries[task_infos[index].heap_index] == &task_infos[index]);
+		}
+		else
+		{
+			members = members && (task_infos[index].heap_index == heapINDEX_NONE);
+		}
+	}
+
+	check("heap order", ordered);
+	check("heap indexes point back at their entries", indexed);
+	check("active tasks are the heap entries", members && (in_heap == active_heap.length) && (in_heap + idle_count == active_count));
+
+	verify_count++;
+}
+
+static void stress_task(void *pvParameters)
+{
+	uint32_t operation;
+	uint32_t choice;
+	uint64_t start;
+	uint64_t elapsed = 0;
+
+	(void) pvParameters;
+
+	while(idle_count > 0)
+	{
+		release_task();
+	}
+
+	verify_heap();
+
+	for(operation = 0; operation < operation_count; operation++)
+	{
+		choice = bench_random_next(&random_state);
+		start = bench_now_ns();
+
+		if((active_heap.length <= active_count / 2) || ((idle_count > 0) && (choice & 1)))
+		{
+			release_task();
+		}
+		else if((choice & 6) == 0)
+		{
+			expire_earliest_task();
+		}
+		else
+		{
+			complete_task();
+		}
+
+		elapsed += bench_now_ns() - start;
+
+		if(((operation + 1) % benchVERIFY_INTERVAL) == 0)
+		{
+			verify_heap();
+		}
+	}
+
+	verify_heap();
+
+	printf("Stress: %u active tasks, %u releases, %u completions, %u overdue, %.0f ns per operation\n", active_count,
+		release_count, complete_count, overdue_count, (double)elapsed / (double)operation_count);
+	printf("Stress: tick 0x%08X to 0x%08X, %u whole heap checks\n", (unsigned int)benchSTART_TIME, (unsigned int)current_time,
+		verify_count);
+	printf("Stress: %u checks failed\n", failed_checks);
+
+	exit((failed_checks == 0) ? 0 : 1);
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t index;
+
+	if(argc > 1)
+	{
+		operation_count = (uint32_t)strtoul(argv[1], NULL, 10);
+	}
+
+	if(argc > 2)
+	{
+		active_count = (uint32_t)strtoul(argv[2], NULL, 10);
+	}
+
+	if((operation_count == 0) || (active_count < 2) || (active_count > benchMAX_ACTIVE))
+	{
+		fprintf(stderr, "usage: %s [operations] [active 2..%d]\n", argv[0], benchMAX_ACTIVE);
+		return 2;
+	}
+
+	for(index = 0; index < active_count; index++)
+	{
+		task_infos[index].task_id = index;
+		task_infos[index].heap_index = heapINDEX_NONE;
+		idle_task_infos[idle_count++] = &task_infos[index];
+	}
+
+	xTaskCreate(stress_task, "Stress", configMINIMAL_STACK_SIZE * 2, NULL, benchTASK_PRIORITY, NULL);
+	vTaskStartScheduler();
+
+	return 1;
+}
@@ -0,0 +1,141 @@
+/**
+  ******************************************************************************
+  * @file    dds_switch.c
+  * @brief   Host benchmark of the FreeRTOS context switch and task selection.
+  *
+  *          Built twice with configMAX_PRIORITIES 32, once with the generic
+  *          task selection (configUSE_PORT_OPTIMISED_TASK_SELECTION 0), which
+  *          scans the ready lists down from the highest ready priority, and
+  *          once with the ready priority bitmap and __builtin_clz() of the
+  *          POSIX port (configUSE_PORT_OPTIMISED_TASK_SELECTION 1).
+  *
+  *          The bench task runs at benchLOW_PRIORITY and gives a semaphore that
+  *          a task at a higher priority waits on. The waiter preempts it, takes
+  *          the semaphore again and blocks, after which the kernel has to find
+  *          the bench task again from the waiter's priority down. The waiter's
+  *          priority is raised step by step to configMAX_PRIORITIES - 1, for
+  *          each step the median round trip (two context switches) and the
+  *          median and 99th percentile time spent in vTaskSwitchContext(),
+  *          wrapped at link time (-Wl,--wrap), are reported. Medians, as
+  *          host scheduling noise swamps the means.
+  *
+  *          Usage: dds_switch [rounds]
+  ******************************************************************************
+  */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#include "bench.h"
+
+#define benchDEFAULT_ROUNDS					100000
+#define benchMAX_SAMPLES					(1 << 20)
+#define benchLOW_PRIORITY					1
+
+#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+	#define benchBACKEND					"clz"
+#else
+	#define benchBACKEND					"generic"
+#endif
+
+void __real_vTaskSwitchContext(void);
+
+static const UBaseType_t waiter_priorities[] = { 2, 4, 8, 16, configMAX_PRIORITIES - 1 };
+
+static SemaphoreHandle_t wake_semaphore;
+static TaskHandle_t waiter_handle;
+static uint32_t round_count = benchDEFAULT_ROUNDS;
+
+static volatile int sampling = 0;
+static uint32_t round_ns[benchMAX_SAMPLES];
+static uint32_t select_ns[benchMAX_SAMPLES];
+static bench_samples_t round_samples = { round_ns, benchMAX_SAMPLES, 0, 0 };
+static bench_samples_t select_samples = { select_ns, benchMAX_SAMPLES, 0, 0 };
+
+void __wrap_vTaskSwitchContext(void)
+{
+	uint64_t start = bench_now_ns();
+
+	__real_vTaskSwitchContext();
+
+	if(sampling)
+	{
+		bench_add_sample(&select_samples, bench_now_ns() - start);
+	}
+}
+
+static void waiter_task(void *pvParameters)
+{
+	(void) pvParameters;
+
+	while(1)
+	{
+		xSemaphoreTake(wake_semaphore, portMAX_DELAY);
+	}
+}
+
+static void bench_task(void *pvParameters)
+{
+	uint32_t index;
+	uint32_t round;
+	uint64_t start;
+
+	(void) pvParameters;
+
+	for(index = 0; index < sizeof(waiter_priorities) / sizeof(waiter_priorities[0]); index++)
+	{
+		vTaskPrioritySet(waiter_handle, waiter_priorities[index]);
+
+		taskENTER_CRITICAL();
+		round_samples.count = 0;
+		round_samples.total = 0;
+		select_samples.count = 0;
+		select_samples.total = 0;
+		sampling = 1;
+		taskEXIT_CRITICAL();
+
+		for(round = 0; round < round_count; round++)
+		{
+			start = bench_now_ns();
+			xSemaphoreGive(wake_semaphore);
+			bench_add_sample(&round_samples, bench_now_ns() - start);
+		}
+
+		taskENTER_CRITICAL();
+		sampling = 0;
+		bench_sort_samples(&round_samples);
+		bench_sort_samples(&select_samples);
+		printf("Switch (%s): waiter at priority %2u, round trip median %6u ns, vTaskSwitchContext median %4u ns, p99 %5u ns\n",
+			benchBACKEND, (uint32_t)waiter_priorities[index], bench_sample_percentile(&round_samples, 50),
+			bench_sample_percentile(&select_samples, 50), bench_sample_percentile(&select_samples, 99));
+		taskEXIT_CRITICAL();
+	}
+
+	exit(0);
+}
+
+int main(int argc, char **argv)
+{
+	if(argc > 1)
+	{
+		round_count = (uint32_t)strtoul(argv[1], NULL, 10);
+	}
+
+	if((round_count == 0) || (round_count > benchMAX_SAMPLES / 2))
+	{
+		fprintf(stderr, "usage: %s [rounds 1..%d]\n", argv[0], benchMAX_SAMPLES / 2);
+		return 2;
+	}
+
+	wake_semaphore = xSemaphoreCreateBinary();
+	xTaskCreate(waiter_task, "Waiter", configMINIMAL_STACK_SIZE, NULL, waiter_priorities[0], &waiter_handle);
+	xTaskCreate(bench_task, "Bench", configMINIMAL_STACK_SIZE * 2, NULL, benchLOW_PRIORITY, NULL);
+	vTaskStartScheduler();
+
+	return 1;
+}
@@ -0,0 +1,134 @@
+/**
+  ******************************************************************************
+  * @file    dds_timers.c
+  * @brief   Host benchmark of the FreeRTOS software timer backends.
+  *
+  *          Built twice against FreeRTOS_Source/timers.c, once with the
+  *          sorted active timer lists (configUSE_TIMER_WHEEL 0) and once
+  *          with the hierarchical timing wheel (configUSE_TIMER_WHEEL 1).
+  *          A task below the timer service task arms benchTIMERS timers,
+  *          restarts random ones benchCHURN times with a new period and
+  *          stops them all, so every command is processed by the timer
+  *          service task before the next one is sent. Reports the mean
+  *          wall time of one command in each phase.
+  *
+  *          Usage: dds_timers [timers] [restarts]
+  *
+  *          Periods are uniform in [benchMIN_PERIOD, benchMAX_PERIOD) ticks,
+  *          so no timer expires while the benchmark runs.
+  ******************************************************************************
+  */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#include "bench.h"
+
+#define benchMAX_TIMERS						65536
+#define benchDEFAULT_TIMERS					10000
+#define benchDEFAULT_CHURN					100000
+#define benchMIN_PERIOD						100000
+#define benchMAX_PERIOD						1000000
+#define benchTASK_PRIORITY					( configTIMER_TASK_PRIORITY - 1 )
+
+#if ( configUSE_TIMER_WHEEL == 1 )
+	#define benchBACKEND					"wheel"
+#else
+	#define benchBACKEND					"list"
+#endif
+
+static StaticTimer_t timer_storage[benchMAX_TIMERS];
+static TimerHandle_t timers[benchMAX_TIMERS];
+static uint32_t timer_count = benchDEFAULT_TIMERS;
+static uint32_t churn_count = benchDEFAULT_CHURN;
+
+static uint64_t random_state = benchRANDOM_SEED;
+
+static uint32_t random_period(void)
+{
+	return benchMIN_PERIOD + (bench_random_next(&random_state) % (benchMAX_PERIOD - benchMIN_PERIOD));
+}
+
+static void timer_callback(TimerHandle_t xTimer)
+{
+	(void) xTimer;
+}
+
+static void report(const char *pphase, uint32_t commands, uint64_t elapsed_ns)
+{
+	printf("Timers (%s): %-7s %7u commands, %8.0f ns per command\n", benchBACKEND, pphase, commands, (double)elapsed_ns / (double)commands);
+}
+
+// Runs below the timer service task, which therefore preempts it on every
+// command and returns only once the command has been processed
+static void bench_task(void *pvParameters)
+{
+	uint64_t start;
+	uint32_t index;
+	uint32_t restart;
+
+	(void) pvParameters;
+
+	start = bench_now_ns();
+
+	for(index = 0; index < timer_count; index++)
+	{
+		xTimerStart(timers[index], portMAX_DELAY);
+	}
+
+	report("arm", timer_count, bench_now_ns() - start);
+	start = bench_now_ns();
+
+	for(restart = 0; restart < churn_count; restart++)
+	{
+		xTimerChangePeriod(timers[bench_random_next(&random_state) % timer_count], random_period(), portMAX_DELAY);
+	}
+
+	report("restart", churn_count, bench_now_ns() - start);
+	start = bench_now_ns();
+
+	for(index = 0; index < timer_count; index++)
+	{
+		xTimerStop(timers[index], portMAX_DELAY);
+	}
+
+	report("stop", timer_count, bench_now_ns() - start);
+
+	exit(0);
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t index;
+
+	if(argc > 1)
+	{
+		timer_count = (uint32_t)strtoul(argv[1], NULL, 10);
+	}
+
+	if(argc > 2)
+	{
+		churn_count = (uint32_t)strtoul(argv[2], NULL, 10);
+	}
+
+	if((timer_count == 0) || (timer_count > benchMAX_TIMERS))
+	{
+		fprintf(stderr, "usage: %s [timers 1..%d] [restarts]\n", argv[0], benchMAX_TIMERS);
+		return 2;
+	}
+
+	for(index = 0; index < timer_count; index++)
+	{
+		timers[index] = xTimerCreateStatic("Bench", random_period(), pdFALSE, NULL, timer_callback, &timer_storage[index]);
+	}
+
+	xTaskCreate(bench_task, "Bench", configMINIMAL_STACK_SIZE * 2, NULL, benchTASK_PRIORITY, NULL);
+	vTaskStartScheduler();
+
+	return 1;
+}
@@ -0,0 +1,289 @@
+/**
+  ******************************************************************************
+  * @file    dds_trace.c
+  * @brief   Converts a dump of the DD binary trace (src/dd_trace.h) to the
+  *          Chrome trace event JSON format, which chrome://tracing and
+  *          https://ui.perfetto.dev open directly.
+  *
+  *          Usage: dds_trace <dump file> [JSON file, default stdout]
+  *
+  *          FreeRTOS tasks become threads of the "FreeRTOS" process, with a
+  *          slice for every time they ran and a priority counter. Every DD
+  *          task id becomes a thread of the "DD tasks" process, with an
+  *          async slice from the release to the completion of each job and
+  *          instant events for overdue jobs, rejections and dispatches.
+  ******************************************************************************
+  */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "dd_trace.h"
+
+#define decodeMAX_DD_TASKS					256
+#define decodeMAX_PENDING_JOBS				64
+#define decodeKERNEL_PID					1
+#define decodeDD_PID						2
+
+// Jobs of one DD task released but not completed yet, oldest first
+typedef struct pending_jobs
+{
+	uint32_t job_ids[decodeMAX_PENDING_JOBS];
+	uint32_t head;
+	uint32_t length;
+	int seen;
+} pending_jobs_t;
+
+// The dump header, its ring is read into pring_records whatever length the DDS was built with
+static dd_trace_t trace;
+static dd_trace_record_t *pring_records;
+static dd_trace_record_t *precords;
+static pending_jobs_t pending_jobs[decodeMAX_DD_TASKS];
+static int task_running[traceMAX_TASKS];
+static FILE *poutput;
+static int first_event = 1;
+
+static int compare_records(const void *pfirst, const void *psecond)
+{
+	uint32_t first = ((const dd_trace_record_t *)pfirst)->sequence;
+	uint32_t second = ((const dd_trace_record_t *)psecond)->sequence;
+
+	return (first < second) ? -1 : ((first > second) ? 1 : 0);
+}
+
+static const char *task_name(uint32_t task)
+{
+	static char fallback[32];
+
+	if((task < traceMAX_TASKS) && (trace.task_names[task][0] != '\0'))
+	{
+		return trace.task_names[task];
+	}
+
+	snprintf(fallback, sizeof(fallback), "task %u", task);
+
+	return fallback;
+}
+
+static void begin_event(void)
+{
+	fprintf(poutput, first_event ? "\n" : ",\n");
+	first_event = 0;
+}
+
+static void print_instant(uint32_t pid, uint32_t tid, double timestamp, const char *pname, const char *pargument_name, uint32_t argument)
+{
+	begin_event();
+	fprintf(poutput, "{\"ph\":\"i\",\"s\":\"t\",\"pid\":%u,\"tid\":%u,\"ts\":%.3f,\"name\":\"%s\",\"args\":{\"%s\":%u}}", pid, tid, timestamp, pname, pargument_name, argument);
+}
+
+static void print_metadata(void)
+{
+	uint32_t task;
+
+	begin_event();
+	fprintf(poutput, "{\"ph\":\"M\",\"pid\":%d,\"name\":\"process_name\",\"args\":{\"name\":\"FreeRTOS\"}}", decodeKERNEL_PID);
+	begin_event();
+	fprintf(poutput, "{\"ph\":\"M\",\"pid\":%d,\"name\":\"process_name\",\"args\":{\"name\":\"DD tasks\"}}", decodeDD_PID);
+	begin_event();
+	fprintf(poutput, "{\"ph\":\"M\",\"pid\":%d,\"tid\":0,\"name\":\"thread_name\",\"args\":{\"name\":\"kernel\"}}", decodeKERNEL_PID);
+
+	for(task = 1; task < traceMAX_TASKS; task++)
+	{
+		if(trace.task_names[task][0] != '\0')
+		{
+			begin_event();
+			fprintf(poutput, "{\"ph\":\"M\",\"pid\":%d,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":\"%s\"}}", decodeKERNEL_PID, task, trace.task_names[task]);
+		}
+	}
+}
+
+static void convert_record(dd_trace_record_t *precord, double timestamp, uint32_t *pnext_job_id)
+{
+	pending_jobs_t *ppending = (precord->task < decodeMAX_DD_TASKS) ? &pending_jobs[precord->task] : NULL;
+	uint32_t job_id;
+
+	switch(precord->event)
+	{
+		case TRACE_TASK_CREATE:
+			print_instant(decodeKERNEL_PID, precord->task, timestamp, "create", "task", precord->task);
+			break;
+
+		case TRACE_TASK_SWITCHED_IN:
+			if(precord->task < traceMAX_TASKS)
+			{
+				begin_event();
+				fprintf(poutput, "{\"ph\":\"B\",\"pid\":%d,\"tid\":%u,\"ts\":%.3f,\"name\":\"%s\"}", decodeKERNEL_PID, precord->task, timestamp, task_name(precord->task));
+				task_running[precord->task] = 1;
+			}
+			break;
+
+		case TRACE_TASK_SWITCHED_OUT:
+			// The dump may start in the middle of a slice, its begin is gone
+			if((precord->task < traceMAX_TASKS) && task_running[precord->task])
+			{
+				begin_event();
+				fprintf(poutput, "{\"ph\":\"E\",\"pid\":%d,\"tid\":%u,\"ts\":%.3f}", decodeKERNEL_PID, precord->task, timestamp);
+				task_running[precord->task] = 0;
+			}
+			break;
+
+		case TRACE_TASK_PRIORITY_SET:
+			begin_event();
+			fprintf(poutput, "{\"ph\":\"C\",\"pid\":%d,\"ts\":%.3f,\"name\":\"priority %s\",\"args\":{\"priority\":%u}}", decodeKERNEL_PID, timestamp, task_name(precord->task), precord->argument);
+			break;
+
+		case TRACE_TIMER_EXPIRED:
+			print_instant(decodeKERNEL_PID, 0, timestamp, "timer expired", "timer", precord->argument);
+			break;
+
+		case TRACE_DD_RELEASE:
+			if(ppending == NULL)
+			{
+				break;
+			}
+
+			if(!ppending->seen)
+			{
+				begin_event();
+				fprintf(poutput, "{\"ph\":\"M\",\"pid\":%d,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":\"DD task %u\"}}", decodeDD_PID, precord->task, precord->task);
+				ppending->seen = 1;
+			}
+
+			job_id = (*pnext_job_id)++;
+			begin_event();
+			fprintf(poutput, "{\"ph\":\"b\",\"cat\":\"job\",\"id\":%u,\"pid\":%d,\"tid\":%u,\"ts\":%.3f,\"name\":\"DD task %u job\",\"args\":{\"deadline\":%u}}", job_id, decodeDD_PID, precord->task, timestamp, precord->task, precord->argument);
+
+			if(ppending->length < decodeMAX_PENDING_JOBS)
+			{
+				ppending->job_ids[(ppending->head + ppending->length) % decodeMAX_PENDING_JOBS] = job_id;
+				ppending->length++;
+			}
+			break;
+
+		case TRACE_DD_COMPLETE:
+			// Jobs of one DD task complete in release order, a completion whose release is gone is an instant
+			if((ppending == NULL) || (ppending->length == 0))
+			{
+				print_instant(decodeDD_PID, precord->task, timestamp, "completed", "tick", precord->argument);
+				break;
+			}
+
+			job_id = ppending->job_ids[ppending->head];
+			ppending->head = (ppending->head + 1) % decodeMAX_PENDING_JOBS;
+			ppending->length--;
+			begin_event();
+			fprintf(poutput, "{\"ph\":\"e\",\"cat\":\"job\",\"id\":%u,\"pid\":%d,\"tid\":%u,\"ts\":%.3f,\"name\":\"DD task %u job\",\"args\":{\"completion\":%u}}", job_id, decodeDD_PID, precord->task, timestamp, precord->task, precord->argument);
+			break;
+
+		case TRACE_DD_OVERDUE:
+			print_instant(decodeDD_PID, precord->task, timestamp, "overdue", "tick", precord->argument);
+			break;
+
+		case TRACE_DD_REJECT:
+			print_instant(decodeDD_PID, precord->task, timestamp, "rejected", "execution time", precord->argument);
+			break;
+
+		case TRACE_DD_DISPATCH:
+			print_instant(decodeDD_PID, precord->task, timestamp, "dispatch", "worker", precord->argument);
+			break;
+
+		default:
+			break;
+	}
+}
+
+int main(int argc, char **argv)
+{
+	FILE *pinput;
+	uint32_t record_count = 0;
+	uint32_t next_job_id = 1;
+	uint64_t base_timestamp;
+	uint32_t index;
+
+	if((argc < 2) || (argc > 3))
+	{
+		fprintf(stderr, "usage: %s <dump file> [JSON file]\n", argv[0]);
+		return 2;
+	}
+
+	pinput = fopen(argv[1], "rb");
+
+	if(pinput == NULL)
+	{
+		fprintf(stderr, "dds_trace: cannot open %s\n", argv[1]);
+		return 2;
+	}
+
+	if(fread(&trace, offsetof(dd_trace_t, ring), 1, pinput) != 1)
+	{
+		fprintf(stderr, "dds_trace: %s is shorter than a trace dump\n", argv[1]);
+		fclose(pinput);
+		return 2;
+	}
+
+	if((trace.magic != traceMAGIC) || (trace.version != traceVERSION) || (trace.record_size != sizeof(dd_trace_record_t)) ||
+		(trace.ring_length == 0) || ((trace.ring_length & (trace.ring_length - 1)) != 0) ||
+		(trace.task_name_length != traceTASK_NAME_LENGTH) || (trace.cycles_per_us == 0))
+	{
+		fprintf(stderr, "dds_trace: %s is not a version %d trace dump of this layout\n", argv[1], traceVERSION);
+		fclose(pinput);
+		return 2;
+	}
+
+	pring_records = (dd_trace_record_t *)malloc(trace.ring_length * sizeof(dd_trace_record_t));
+	precords = (dd_trace_record_t *)malloc(trace.ring_length * sizeof(dd_trace_record_t));
+
+	if((pring_records == NULL) || (precords == NULL) || (fread(pring_records, sizeof(dd_trace_record_t), trace.ring_length, pinput) != trace.ring_length))
+	{
+		fprintf(stderr, "dds_trace: %s is shorter than its %u record ring\n", argv[1], trace.ring_length);
+		fclose(pinput);
+		return 2;
+	}
+
+	fclose(pinput);
+
+	// A slot holds a complete record only when its sequence maps back to the slot
+	for(index = 0; index < trace.ring_length; index++)
+	{
+		if((pring_records[index].sequence != 0) && (((pring_records[index].sequence - 1) & (trace.ring_length - 1)) == index))
+		{
+			precords[record_count++] = pring_records[index];
+		}
+	}
+
+	qsort(precords, record_count, sizeof(dd_trace_record_t), compare_records);
+
+	poutput = (argc == 3) ? fopen(argv[2], "w") : stdout;
+
+	if(poutput == NULL)
+	{
+		fprintf(stderr, "dds_trace: cannot create %s\n", argv[2]);
+		return 2;
+	}
+
+	base_timestamp = (record_count > 0) ? precords[0].timestamp : 0;
+
+	fprintf(poutput, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+	print_metadata();
+
+	for(index = 0; index < record_count; index++)
+	{
+		convert_record(&precords[index], (double)(precords[index].timestamp - base_timestamp) / (double)trace.cycles_per_us, &next_job_id);
+	}
+
+	fprintf(poutput, "\n]}\n");
+
+	if(poutput != stdout)
+	{
+		fclose(poutput);
+	}
+
+	fprintf(stderr, "dds_trace: %u records, %u lost to the ring wrapping or torn\n", record_count, trace.head - record_count);
+
+	return 0;
+}
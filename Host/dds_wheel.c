@@ -0,0 +1,204 @@
+/**
+  ******************************************************************************
+  * @file    dds_wheel.c
+  * @brief   Host test of the software timer wheel (configUSE_TIMER_WHEEL) in
+  *          FreeRTOS_Source/timers.c.
+  *
+  *          A task below the timer service task arms one-shot timers on
+  *          either side of the level 0/1/2/3 slot boundaries, in the middle
+  *          of slots and beyond the 2^20 ticks of the wheel, in its far list,
+  *          together with auto reload timers whose periods step over the same
+  *          boundaries, and waits for all of them. It does so from a level 3
+  *          boundary, from one tick before one, and from before the 32-bit
+  *          tick count wraps, mid-slot and on its last tick, so the timers
+  *          expire across the wrap.
+  *
+  *          The interval timer is stopped and the idle task raises the tick
+  *          itself, stepping the tick count over the idle ticks with tickless
+  *          idle, so the tick only moves while every task waits. A callback
+  *          thus reads the tick it was due at: every one must run on exactly
+  *          its expiry tick, an auto reload timer on its start tick plus a
+  *          whole number of periods, and every timer as often as it was armed
+  *          for.
+  *
+  *          Usage: dds_wheel
+  *
+  *          Prints the callbacks checked from each start tick and exits with
+  *          1 if any check failed.
+  ******************************************************************************
+  */
+
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#define benchTASK_PRIORITY					( configTIMER_TASK_PRIORITY - 1 )
+#define benchMAX_REPORTED					10
+
+typedef struct wheel_timer
+{
+	TickType_t period;
+	uint32_t fires;						// 1 for a one-shot timer
+	UBaseType_t auto_reload;
+	StaticTimer_t timer_storage;
+	TimerHandle_t timer_handle;
+	TickType_t start_time;
+	uint32_t fire_count;
+} wheel_timer_t;
+
+static wheel_timer_t wheel_timers[] =
+{
+	// One-shots around the level 1, 2 and 3 boundaries and mid-slot
+	{ 1, 1, pdFALSE }, { 31, 1, pdFALSE }, { 32, 1, pdFALSE }, { 33, 1, pdFALSE }, { 677, 1, pdFALSE },
+	{ 1023, 1, pdFALSE }, { 1024, 1, pdFALSE }, { 1025, 1, pdFALSE }, { 23130, 1, pdFALSE },
+	{ 32767, 1, pdFALSE }, { 32768, 1, pdFALSE }, { 32769, 1, pdFALSE }, { 678490, 1, pdFALSE },
+	// and around the span of the wheel and in its far list
+	{ 0xFFFFF, 1, pdFALSE }, { 0x100000, 1, pdFALSE }, { 0x100001, 1, pdFALSE }, { 0x1A5A5A, 1, pdFALSE },
+	{ 0x300005, 1, pdFALSE }, { 0x40000000, 1, pdFALSE },
+	// Auto reloads, the last period is reloaded into the far list every time
+	{ 7, 40, pdTRUE }, { 33, 40, pdTRUE }, { 1000, 40, pdTRUE }, { 40000, 30, pdTRUE }, { 1500000, 3, pdTRUE }
+};
+
+// Ticks the timers are armed at: a level 3 boundary, one tick before one,
+// mid-slot before the tick count wraps and on its last tick
+static const TickType_t start_times[] = { 0x00100000, 0x800FFFFF, 0xFFEFCFC7, 0xFFFFFFFF };
+
+static uint32_t callback_count = 0;
+static uint32_t failed_checks = 0;
+static uint32_t sleep_count = 0;
+
+// ptimer is NULL for a check of the test task
+static void check(const wheel_timer_t *ptimer, const char *pname, bool passed)
+{
+	if(!passed)
+	{
+		// Only the first few, a broken wheel fails on every callback after
+		if((failed_checks < benchMAX_REPORTED) && (ptimer == NULL))
+		{
+			printf("Wheel: %s FAILED at tick 0x%08X\n", pname, (uint32_t)xTaskGetTickCount());
+		}
+		else if(failed_checks < benchMAX_REPORTED)
+		{
+			printf("Wheel: timer of period %u from tick 0x%08X: %s FAILED at tick 0x%08X\n", (uint32_t)ptimer->period,
+				(uint32_t)ptimer->start_time, pname, (uint32_t)xTaskGetTickCount());
+		}
+
+		failed_checks++;
+	}
+}
+
+static void timer_callback(TimerHandle_t xTimer)
+{
+	wheel_timer_t *ptimer = (wheel_timer_t *)pvTimerGetTimerID(xTimer);
+	TickType_t now = xTaskGetTickCount();
+
+	callback_count++;
+	ptimer->fire_count++;
+
+	check(ptimer, "fired after its last expiry", ptimer->fire_count <= ptimer->fires);
+	// Counted from the start, an auto reload that slipped once stays off
+	check(ptimer, "fired on its expiry tick", now == (TickType_t)(ptimer->start_time + (ptimer->fire_count * ptimer->period)));
+
+	if(ptimer->auto_reload == pdTRUE)
+	{
+		check(ptimer, "reloaded a period after its expiry tick", xTimerGetExpiryTime(xTimer) == (TickType_t)(now + ptimer->period));
+
+		if(ptimer->fire_count == ptimer->fires)
+		{
+			// The callback runs in the timer service task, which must not block
+			check(ptimer, "stopped", xTimerStop(xTimer, 0) == pdPASS);
+		}
+	}
+}
+
+static void wheel_task(void *pvParameters)
+{
+	struct itimerval stopped;
+	TickType_t span;
+	uint32_t start;
+	uint32_t index;
+	uint32_t callbacks_before;
+
+	(void) pvParameters;
+
+	// From here on only the idle task raises the tick
+	memset(&stopped, 0, sizeof(stopped));
+	(void) setitimer(ITIMER_REAL, &stopped, NULL);
+
+	for(start = 0; start < sizeof(start_times) / sizeof(start_times[0]); start++)
+	{
+		span = 0;
+		callbacks_before = callback_count;
+
+		vTaskDelay((TickType_t)(start_times[start] - xTaskGetTickCount()));
+		check(NULL, "woke on the start tick", xTaskGetTickCount() == start_times[start]);
+
+		// The timer service task preempts this one on every start, so all of
+		// them are armed on the same tick
+		for(index = 0; index < sizeof(wheel_timers) / sizeof(wheel_timers[0]); index++)
+		{
+			wheel_timers[index].start_time = xTaskGetTickCount();
+			wheel_timers[index].fire_count = 0;
+			xTimerStart(wheel_timers[index].timer_handle, portMAX_DELAY);
+
+			if(wheel_timers[index].period * wheel_timers[index].fires > span)
+			{
+				span = wheel_timers[index].period * wheel_timers[index].fires;
+			}
+		}
+
+		vTaskDelay(span + 1);
+
+		for(index = 0; index < sizeof(wheel_timers) / sizeof(wheel_timers[0]); index++)
+		{
+			check(&wheel_timers[index], "fired as often as armed for", wheel_timers[index].fire_count == wheel_timers[index].fires);
+			check(&wheel_timers[index], "inactive", xTimerIsTimerActive(wheel_timers[index].timer_handle) == pdFALSE);
+		}
+
+		printf("Wheel: from tick 0x%08X, %3u callbacks checked\n", (uint32_t)start_times[start],
+			callback_count - callbacks_before);
+	}
+
+	printf("Wheel: %u idle sleeps, %u checks failed\n", sleep_count, failed_checks);
+
+	exit((failed_checks == 0) ? 0 : 1);
+}
+
+int main(void)
+{
+	uint32_t index;
+
+	for(index = 0; index < sizeof(wheel_timers) / sizeof(wheel_timers[0]); index++)
+	{
+		wheel_timers[index].timer_handle = xTimerCreateStatic("Wheel", wheel_timers[index].period, wheel_timers[index].auto_reload,
+			&wheel_timers[index], timer_callback, &wheel_timers[index].timer_storage);
+	}
+
+	xTaskCreate(wheel_task, "Wheel", configMINIMAL_STACK_SIZE * 2, NULL, benchTASK_PRIORITY, NULL);
+	vTaskStartScheduler();
+
+	return 1;
+}
+
+// One tick per pass of the idle task, on the idle thread like the interval
+// timer's tick on the thread of the task it preempts
+void vApplicationIdleHook(void)
+{
+	(void) raise(SIGALRM);
+}
+
+// Steps the tick count to one tick before the next task unblocks, the tick the
+// idle hook raises next unblocks it
+void dd_suppress_ticks_and_sleep(uint32_t expected_idle_time)
+{
+	vTaskStepTick(expected_idle_time - 1);
+	sleep_count++;
+}
@@ -0,0 +1,103 @@
+/**
+  ******************************************************************************
+  * @file    stm32f4_discovery.c
+  * @brief   Host (POSIX) stand-in for the STM32F4-Discovery board support.
+  *          LED changes are written to stdout, the user push-button EXTI is
+  *          simulated with SIGUSR2.
+  ******************************************************************************
+  */
+
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "stm32f4_discovery.h"
+
+uint32_t SystemCoreClock = 168000000;
+
+static const char *const led_names[LEDn] = { "Green", "Amber", "Red", "Blue" };
+static volatile uint32_t led_state = 0;
+static volatile uint32_t exti_pending = 0;
+
+void EXTI0_IRQHandler(void) __attribute__((weak));
+
+void EXTI0_IRQHandler(void)
+{
+	EXTI_ClearITPendingBit(EXTI_Line0);
+}
+
+static void button_signal_handler(int signal_number)
+{
+	(void) signal_number;
+
+	exti_pending |= EXTI_Line0;
+	EXTI0_IRQHandler();
+}
+
+void STM_EVAL_LEDInit(Led_TypeDef Led)
+{
+	led_state &= ~(1UL << Led);
+}
+
+void STM_EVAL_LEDOn(Led_TypeDef Led)
+{
+	if((led_state & (1UL << Led)) == 0)
+	{
+		led_state |= (1UL << Led);
+		printf("[led] %s on\n", led_names[Led]);
+	}
+}
+
+void STM_EVAL_LEDOff(Led_TypeDef Led)
+{
+	if((led_state & (1UL << Led)) != 0)
+	{
+		led_state &= ~(1UL << Led);
+		printf("[led] %s off\n", led_names[Led]);
+	}
+}
+
+void STM_EVAL_LEDToggle(Led_TypeDef Led)
+{
+	if((led_state & (1UL << Led)) != 0)
+	{
+		STM_EVAL_LEDOff(Led);
+	}
+	else
+	{
+		STM_EVAL_LEDOn(Led);
+	}
+}
+
+void STM_EVAL_PBInit(Button_TypeDef Button, ButtonMode_TypeDef Button_Mode)
+{
+	struct sigaction button_action;
+
+	(void) Button;
+
+	if(Button_Mode == BUTTON_MODE_EXTI)
+	{
+		memset(&button_action, 0, sizeof(button_action));
+		button_action.sa_handler = button_signal_handler;
+		button_action.sa_flags = SA_RESTART;
+		sigfillset(&button_action.sa_mask);
+		sigaction(SIGUSR2, &button_action, NULL);
+	}
+}
+
+uint32_t STM_EVAL_PBGetState(Button_TypeDef Button)
+{
+	(void) Button;
+
+	return 0;
+}
+
+ITStatus EXTI_GetITStatus(uint32_t EXTI_Line)
+{
+	return ((exti_pending & EXTI_Line) != 0) ? SET : RESET;
+}
+
+void EXTI_ClearITPendingBit(uint32_t EXTI_Line)
+{
+	exti_pending &= ~EXTI_Line;
+}
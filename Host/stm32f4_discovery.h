@@ -0,0 +1,46 @@
+/**
+  ******************************************************************************
+  * @file    stm32f4_discovery.h
+  * @brief   Host (POSIX) stand-in for the STM32F4-Discovery board header.
+  *          LEDs are logged to stdout and the user push-button is raised
+  *          with SIGUSR2 (kill -USR2 <pid>), which calls EXTI0_IRQHandler.
+  ******************************************************************************
+  */
+
+#ifndef __STM32F4_DISCOVERY_H
+#define __STM32F4_DISCOVERY_H
+
+#include "stm32f4xx.h"
+
+typedef enum
+{
+	LED4 = 0,
+	LED3 = 1,
+	LED5 = 2,
+	LED6 = 3
+} Led_TypeDef;
+
+typedef enum
+{
+	BUTTON_USER = 0,
+} Button_TypeDef;
+
+typedef enum
+{
+	BUTTON_MODE_GPIO = 0,
+	BUTTON_MODE_EXTI = 1
+} ButtonMode_TypeDef;
+
+#define LEDn							4
+#define BUTTONn							1
+#define USER_BUTTON_EXTI_LINE			EXTI_Line0
+#define USER_BUTTON_EXTI_IRQn			EXTI0_IRQn
+
+void STM_EVAL_LEDInit(Led_TypeDef Led);
+void STM_EVAL_LEDOn(Led_TypeDef Led);
+void STM_EVAL_LEDOff(Led_TypeDef Led);
+void STM_EVAL_LEDToggle(Led_TypeDef Led);
+void STM_EVAL_PBInit(Button_TypeDef Button, ButtonMode_TypeDef Button_Mode);
+uint32_t STM_EVAL_PBGetState(Button_TypeDef Button);
+
+#endif /* __STM32F4_DISCOVERY_H */
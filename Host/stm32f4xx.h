@@ -0,0 +1,34 @@
+/**
+  ******************************************************************************
+  * @file    stm32f4xx.h
+  * @brief   Host (POSIX) stand-in for the CMSIS STM32F4xx device header.
+  *          Only the definitions used by src/ are provided, the NVIC and
+  *          EXTI accessors are no-ops on the host.
+  ******************************************************************************
+  */
+
+#ifndef __STM32F4xx_H
+#define __STM32F4xx_H
+
+#include <stdint.h>
+
+#define __NVIC_PRIO_BITS		4
+
+typedef enum IRQn
+{
+	EXTI0_IRQn = 6
+} IRQn_Type;
+
+typedef enum {RESET = 0, SET = !RESET} FlagStatus, ITStatus;
+
+#define EXTI_Line0				( ( uint32_t ) 0x00001 )
+
+extern uint32_t SystemCoreClock;
+
+static inline void NVIC_SetPriorityGrouping(uint32_t PriorityGroup) { (void) PriorityGroup; }
+static inline void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority) { (void) IRQn; (void) priority; }
+
+ITStatus EXTI_GetITStatus(uint32_t EXTI_Line);
+void EXTI_ClearITPendingBit(uint32_t EXTI_Line);
+
+#endif /* __STM32F4xx_H */
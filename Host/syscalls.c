@@ -0,0 +1,45 @@
+/**
+  ******************************************************************************
+  * @file    syscalls.c
+  * @brief   Host (POSIX) replacement for src/syscalls.c and tiny_printf.c.
+  *
+  *          Task threads can be switched out at any instruction by the tick,
+  *          so printf must not take the stdio lock: format into a local
+  *          buffer and hand it to write(2) in one go, as tiny_printf does
+  *          with _write on the target.
+  ******************************************************************************
+  */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#define HOST_PRINTF_BUFFER_LENGTH	256
+
+int _write(int file, char *ptr, int len)
+{
+	return (int) write(file, ptr, (size_t) len);
+}
+
+int printf(const char *fmt, ...)
+{
+	char buf[HOST_PRINTF_BUFFER_LENGTH];
+	int length;
+	va_list va;
+
+	va_start(va, fmt);
+	length = vsnprintf(buf, sizeof(buf), fmt, va);
+	va_end(va);
+
+	if(length > (int) sizeof(buf) - 1)
+	{
+		length = (int) sizeof(buf) - 1;
+	}
+
+	if(length > 0)
+	{
+		length = _write(1, buf, length);
+	}
+
+	return length;
+}
@@ -0,0 +1,58 @@
+/**
+  ******************************************************************************
+  * @file    trace_dump.c
+  * @brief   Host (POSIX) export of the binary trace recorder.
+  *
+  *          On the target the dd_trace object is read out with a debugger,
+  *          e.g. "dump binary value dd_trace.bin dd_trace" in gdb. The host
+  *          build writes the same bytes to the file named by the DDS_TRACE
+  *          environment variable when it is stopped by SIGINT or SIGTERM.
+  ******************************************************************************
+  */
+
+#include <fcntl.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "dd_trace.h"
+
+#define HOST_TRACE_PATH_LENGTH	256
+
+static char trace_path[HOST_TRACE_PATH_LENGTH];
+
+// Only async-signal-safe calls, the handler may interrupt any task thread
+static void trace_dump_signal_handler(int signal_number)
+{
+	int file;
+
+	file = open(trace_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+	if(file >= 0)
+	{
+		(void) write(file, &dd_trace, sizeof(dd_trace));
+		(void) close(file);
+	}
+
+	_exit(128 + signal_number);
+}
+
+static void __attribute__((constructor)) trace_dump_init(void)
+{
+	struct sigaction dump_action;
+	const char *ppath = getenv("DDS_TRACE");
+
+	if((ppath == NULL) || (ppath[0] == '\0') || (strlen(ppath) >= HOST_TRACE_PATH_LENGTH))
+	{
+		return;
+	}
+
+	strcpy(trace_path, ppath);
+
+	memset(&dump_action, 0, sizeof(dump_action));
+	dump_action.sa_handler = trace_dump_signal_handler;
+	sigfillset(&dump_action.sa_mask);
+	sigaction(SIGINT, &dump_action, NULL);
+	sigaction(SIGTERM, &dump_action, NULL);
+}
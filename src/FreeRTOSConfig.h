@@ -90,11 +90,28 @@ extern uint32_t SystemCoreClock;
 #define configUSE_TICK_HOOK				0
 #define configCPU_CLOCK_HZ				( SystemCoreClock )
 #define configTICK_RATE_HZ				( ( TickType_t ) 1000 )
-#define configMAX_PRIORITIES			( 5 )
+/* Priorities 0..configMAX_PRIORITIES-1, the DD tasks use 1..5 (see main.c).
+The ready priorities are kept in a 32-bit bitmap and the highest one is found
+with a count leading zeros instruction (portGET_HIGHEST_PRIORITY() in the
+port's portmacro.h), so selecting the next task takes the same time for any
+number of priorities up to 32. */
+#ifndef configMAX_PRIORITIES
+	#define configMAX_PRIORITIES		( 8 )
+#endif
+#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
+	#define configUSE_PORT_OPTIMISED_TASK_SELECTION	1
+#endif
 #define configMINIMAL_STACK_SIZE		( ( unsigned short ) 130 )
-#define configTOTAL_HEAP_SIZE			( ( size_t ) ( 7 * 1024 ) )
+/* With heap hints the heap is heap_5.c over two regions (src/dd_memory.c): the
+CCM RAM that stm32f4_flash.ld leaves free, where the kernel objects and task
+stacks go, and configTOTAL_HEAP_SIZE bytes of SRAM for DMA reachable memory.
+Set configUSE_HEAP_HINTS to 0 to build heap_4.c or heap_6.c instead. */
+#ifndef configUSE_HEAP_HINTS
+	#define configUSE_HEAP_HINTS		1
+#endif
+#define configTOTAL_HEAP_SIZE			( ( size_t ) ( 12 * 1024 ) )
 #define configMAX_TASK_NAME_LEN			( 10 )
-#define configUSE_TRACE_FACILITY		0
+#define configUSE_TRACE_FACILITY		1
 #define configUSE_16_BIT_TICKS			0
 #define configIDLE_SHOULD_YIELD			1
 #define configUSE_MUTEXES				1
@@ -102,9 +119,43 @@ extern uint32_t SystemCoreClock;
 #define configCHECK_FOR_STACK_OVERFLOW	2
 #define configUSE_RECURSIVE_MUTEXES		1
 #define configUSE_MALLOC_FAILED_HOOK	1
-#define configUSE_APPLICATION_TASK_TAG	0
+#define configUSE_APPLICATION_TASK_TAG	1
 #define configUSE_COUNTING_SEMAPHORES	1
 #define configGENERATE_RUN_TIME_STATS	0
+#define configUSE_TICKLESS_IDLE			1
+#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP	2
+
+/* DD task execution-time accounting (see dd_task_switched_in/out in main.c).
+DD worker tasks carry a pointer to the slot of the job they are running as their
+task tag, every other task has a NULL tag. Both hooks also record the switch in
+the binary trace (src/dd_trace.h), tasks are identified by their TCB number. */
+extern void dd_task_switched_in(void *ptask_tag, uint32_t task_number);
+extern void dd_task_switched_out(void *ptask_tag, uint32_t task_number);
+#define traceTASK_SWITCHED_IN()		dd_task_switched_in( ( void * ) pxCurrentTCB->pxTaskTag, ( uint32_t ) pxCurrentTCB->uxTCBNumber )
+#define traceTASK_SWITCHED_OUT()	dd_task_switched_out( ( void * ) pxCurrentTCB->pxTaskTag, ( uint32_t ) pxCurrentTCB->uxTCBNumber )
+
+/* Remaining FreeRTOS trace macros recorded by the binary trace. A new task's
+trace number is set to its TCB number, so the application records a task by
+uxTaskGetTaskNumber() under the same number as the kernel records it. */
+#include "dd_trace.h"
+#define traceTASK_CREATE( pxNewTCB )					do { ( pxNewTCB )->uxTaskNumber = ( pxNewTCB )->uxTCBNumber; dd_trace_task_created( ( uint32_t ) ( pxNewTCB )->uxTCBNumber, ( pxNewTCB )->pcTaskName ); } while( 0 )
+#define traceTASK_PRIORITY_SET( pxTask, uxNewPriority )	dd_trace_record( TRACE_TASK_PRIORITY_SET, ( uint32_t ) ( pxTask )->uxTCBNumber, ( uint32_t ) ( uxNewPriority ) )
+#define traceTIMER_EXPIRED( pxTimer )					dd_trace_record( TRACE_TIMER_EXPIRED, 0, 0 )
+
+/* Tickless idle goes through dd_suppress_ticks_and_sleep in main.c, which
+counts the sleeps for the monitor and calls the port's
+vPortSuppressTicksAndSleep(). The next DD release and the earliest deadline
+already bound the kernel's expected idle time. */
+extern void dd_suppress_ticks_and_sleep(uint32_t expected_idle_time);
+#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )	dd_suppress_ticks_and_sleep( xExpectedIdleTime )
+
+/* The ready DD workers of TASK_EXECUTION_PRIORITY (see main.c) run earliest
+deadline first in the kernel, vTaskSetDeadline() gives each worker the deadline
+of its job when it is dispatched. */
+#ifndef configUSE_EDF_SCHEDULING
+	#define configUSE_EDF_SCHEDULING	1
+#endif
+#define configEDF_PRIORITY				( 3 )
 
 /* Co-routine definitions. */
 #define configUSE_CO_ROUTINES 		0
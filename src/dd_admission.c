@@ -0,0 +1,327 @@
+/* Standard includes. */
+#include <stddef.h>
+#include <string.h>
+
+#include "dd_admission.h"
+
+// Share execution_time / interval of the processor, rounded up
+static uint64_t processor_share(uint64_t execution_time, uint64_t interval)
+{
+	return ((execution_time << admissionUTILIZATION_SHIFT) + interval - 1) / interval;
+}
+
+static void add_task_to_sums(dd_admission_t *padmission, dd_admission_task_t *ptask)
+{
+	uint64_t utilization = processor_share(ptask->execution_time, ptask->period);
+	uint64_t slack = (uint64_t)(ptask->period - ptask->relative_deadline) * utilization;
+
+	padmission->periodic_utilization += utilization;
+	padmission->periodic_density += processor_share(ptask->execution_time, ptask->relative_deadline);
+
+	// Saturate, the test interval then falls back to the busy period bound
+	padmission->slack_demand = (padmission->slack_demand > UINT64_MAX - slack) ? UINT64_MAX : padmission->slack_demand + slack;
+
+	if(ptask->relative_deadline < padmission->min_relative_deadline)
+	{
+		padmission->min_relative_deadline = ptask->relative_deadline;
+	}
+}
+
+// Rebuild the sums from the admitted tasks, used when one leaves the set
+static void recompute_sums(dd_admission_t *padmission)
+{
+	uint32_t index;
+
+	padmission->periodic_utilization = 0;
+	padmission->periodic_density = 0;
+	padmission->slack_demand = 0;
+	padmission->min_relative_deadline = UINT32_MAX;
+
+	for(index = 0; index < padmission->length; index++)
+	{
+		if(padmission->ptasks[index].admitted)
+		{
+			add_task_to_sums(padmission, &padmission->ptasks[index]);
+		}
+	}
+}
+
+// Processor demand h(t) of the synchronous arrival pattern, the execution time
+// of every job released in [0, t) with its deadline no later than t
+static uint64_t processor_demand(dd_admission_t *padmission, uint64_t interval)
+{
+	dd_admission_task_t *ptask;
+	uint64_t demand = 0;
+	uint32_t index;
+
+	for(index = 0; index < padmission->length; index++)
+	{
+		ptask = &padmission->ptasks[index];
+
+		if(ptask->admitted && (ptask->relative_deadline <= interval))
+		{
+			demand += (((interval - ptask->relative_deadline) / ptask->period) + 1) * ptask->execution_time;
+		}
+	}
+
+	return demand;
+}
+
+// Latest absolute deadline of the synchronous arrival pattern strictly before interval, 0 if none
+static uint64_t last_deadline_before(dd_admission_t *padmission, uint64_t interval)
+{
+	dd_admission_task_t *ptask;
+	uint64_t deadline;
+	uint64_t latest = 0;
+	uint32_t index;
+
+	for(index = 0; index < padmission->length; index++)
+	{
+		ptask = &padmission->ptasks[index];
+
+		if(ptask->admitted && (ptask->relative_deadline < interval))
+		{
+			deadline = ((interval - ptask->relative_deadline - 1) / ptask->period) * ptask->period + ptask->relative_deadline;
+
+			if(deadline > latest)
+			{
+				latest = deadline;
+			}
+		}
+	}
+
+	return latest;
+}
+
+// Length of the interval the demand test has to cover, the smaller of
+// -	La = sum((T - D) * C / T) / (1 - U), undefined at U = 100%
+// -	Lb, the synchronous busy period, w = sum(ceil(w / T) * C) from w = sum(C)
+// Returns 0 when it is longer than admissionMAX_INTERVAL.
+static uint64_t demand_test_interval(dd_admission_t *padmission)
+{
+	uint64_t interval_limit = admissionMAX_INTERVAL + 1;
+	uint64_t free_share;
+	uint64_t busy_period = 0;
+	uint64_t next_busy_period;
+	dd_admission_task_t *ptask;
+	uint32_t index;
+
+	if((padmission->periodic_utilization < admissionUTILIZATION_ONE) && (padmission->slack_demand > 0))
+	{
+		free_share = admissionUTILIZATION_ONE - padmission->periodic_utilization;
+
+		if((padmission->slack_demand / free_share) < interval_limit)
+		{
+			interval_limit = (padmission->slack_demand + free_share - 1) / free_share;
+		}
+	}
+
+	for(index = 0; index < padmission->length; index++)
+	{
+		if(padmission->ptasks[index].admitted)
+		{
+			busy_period += padmission->ptasks[index].execution_time;
+		}
+	}
+
+	while(busy_period < interval_limit)
+	{
+		next_busy_period = 0;
+
+		for(index = 0; index < padmission->length; index++)
+		{
+			ptask = &padmission->ptasks[index];
+
+			if(ptask->admitted)
+			{
+				next_busy_period += ((busy_period + ptask->period - 1) / ptask->period) * ptask->execution_time;
+			}
+		}
+
+		if(next_busy_period == busy_period)
+		{
+			interval_limit = busy_period;
+			break;
+		}
+
+		busy_period = next_busy_period;
+	}
+
+	return (interval_limit > admissionMAX_INTERVAL) ? 0 : interval_limit;
+}
+
+// QPA (Zhang and Burns, 2009): walk the deadlines down from the end of the test
+// interval, jumping straight to h(t) whenever h(t) < t. Exact for EDF with
+// constrained deadlines and usually only a handful of demand evaluations.
+static bool processor_demand_test(dd_admission_t *padmission)
+{
+	uint64_t interval = demand_test_interval(padmission);
+	uint64_t demand;
+
+	padmission->demand_tests++;
+
+	if(interval == 0)
+	{
+		return false;
+	}
+
+	interval = last_deadline_before(padmission, interval);
+
+	while(1)
+	{
+		demand = processor_demand(padmission, interval);
+
+		if(demand > interval)
+		{
+			return false;
+		}
+
+		if(demand <= padmission->min_relative_deadline)
+		{
+			return true;
+		}
+
+		interval = (demand < interval) ? demand : last_deadline_before(padmission, interval);
+	}
+}
+
+// Cheapest test first, utilization and density are O(1) since the sums are
+// kept as tasks are admitted. With every D == T the density is the utilization,
+// so only task sets with constrained deadlines ever reach the demand test.
+static bool task_set_is_schedulable(dd_admission_t *padmission)
+{
+	if(padmission->periodic_utilization > admissionUTILIZATION_ONE)
+	{
+		return false;
+	}
+
+	if(padmission->periodic_density <= admissionUTILIZATION_ONE)
+	{
+		return true;
+	}
+
+	return processor_demand_test(padmission);
+}
+
+void dd_admission_init(dd_admission_t *padmission, dd_admission_task_t *ptasks, uint32_t max_length)
+{
+	memset(padmission, 0, sizeof(dd_admission_t));
+	padmission->ptasks = ptasks;
+	padmission->max_length = max_length;
+	padmission->min_relative_deadline = UINT32_MAX;
+}
+
+dd_admission_task_t *pDd_admission_find_task(dd_admission_t *padmission, uint32_t task_id)
+{
+	uint32_t index;
+
+	for(index = 0; index < padmission->length; index++)
+	{
+		if(padmission->ptasks[index].task_id == task_id)
+		{
+			return &padmission->ptasks[index];
+		}
+	}
+
+	return NULL;
+}
+
+// Admit a periodic task with C <= D <= T into the task set. The decision is
+// made on the first call for a task_id and remembered, later calls only look
+// it up. Returns false when the task set would no longer be schedulable, the
+// parameters are invalid or there is no room to remember the task.
+bool dd_admit_periodic_task(dd_admission_t *padmission, uint32_t task_id, uint32_t period, uint32_t execution_time, uint32_t relative_deadline)
+{
+	dd_admission_task_t *ptask = pDd_admission_find_task(padmission, task_id);
+	dd_admission_t saved_sums;
+
+	if(ptask != NULL)
+	{
+		return ptask->admitted;
+	}
+
+	if(padmission->length >= padmission->max_length)
+	{
+		return false;
+	}
+
+	ptask = &padmission->ptasks[padmission->length++];
+	ptask->task_id = task_id;
+	ptask->period = period;
+	ptask->execution_time = execution_time;
+	ptask->relative_deadline = relative_deadline;
+	ptask->admitted = false;
+
+	if((execution_time == 0) || (execution_time > relative_deadline) || (relative_deadline > period))
+	{
+		return false;
+	}
+
+	saved_sums = *padmission;
+	add_task_to_sums(padmission, ptask);
+	ptask->admitted = true;
+
+	if(!task_set_is_schedulable(padmission))
+	{
+		ptask->admitted = false;
+		padmission->periodic_utilization = saved_sums.periodic_utilization;
+		padmission->periodic_density = saved_sums.periodic_density;
+		padmission->slack_demand = saved_sums.slack_demand;
+		padmission->min_relative_deadline = saved_sums.min_relative_deadline;
+		return false;
+	}
+
+	return true;
+}
+
+// Forget a periodic task, admitted or not. Returns false when it is not known.
+bool dd_remove_periodic_task(dd_admission_t *padmission, uint32_t task_id)
+{
+	dd_admission_task_t *ptask = pDd_admission_find_task(padmission, task_id);
+	bool was_admitted;
+
+	if(ptask == NULL)
+	{
+		return false;
+	}
+
+	was_admitted = ptask->admitted;
+	*ptask = padmission->ptasks[--padmission->length];
+
+	if(was_admitted)
+	{
+		recompute_sums(padmission);
+	}
+
+	return true;
+}
+
+// Density check of an aperiodic job that must finish relative_deadline ticks
+// after its release. The Total Bandwidth Server hands out aperiodic deadlines
+// in release order, so every outstanding aperiodic job is due no later than
+// this one: the job fits when the whole aperiodic backlog, spread over its
+// window, still fits next to the periodic density.
+bool dd_admit_aperiodic_job(dd_admission_t *padmission, uint32_t execution_time, uint32_t relative_deadline)
+{
+	uint64_t backlog = padmission->aperiodic_backlog + execution_time;
+
+	if((execution_time == 0) || (backlog > relative_deadline))
+	{
+		return false;
+	}
+
+	if(padmission->periodic_density + processor_share(backlog, relative_deadline) > admissionUTILIZATION_ONE)
+	{
+		return false;
+	}
+
+	padmission->aperiodic_backlog = backlog;
+
+	return true;
+}
+
+// Called when an admitted aperiodic job completes
+void dd_release_aperiodic_job(dd_admission_t *padmission, uint32_t execution_time)
+{
+	padmission->aperiodic_backlog -= (execution_time < padmission->aperiodic_backlog) ? execution_time : padmission->aperiodic_backlog;
+}
@@ -0,0 +1,56 @@
+/*
+ * Admission control for the DD scheduler, shared with the host benchmark in
+ * Host/dds_admission.c. Periodic DD tasks are admitted once, on their first
+ * release, by the exact EDF processor-demand test (Quick convergence Processor
+ * demand Analysis, QPA); aperiodic jobs go through an O(1) density check on
+ * every release.
+ */
+
+#ifndef DD_ADMISSION_H
+#define DD_ADMISSION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Utilizations and densities are fixed point, admissionUTILIZATION_ONE is 100%.
+// Every per-task share is rounded up, so the sums never understate the load.
+#define admissionUTILIZATION_SHIFT			20
+#define admissionUTILIZATION_ONE			(1ULL << admissionUTILIZATION_SHIFT)
+
+// Longest interval the processor-demand test will check, in ticks. A task set
+// whose test interval is longer (utilization within ~1e-6 of 100%) is rejected.
+#define admissionMAX_INTERVAL				(1ULL << 40)
+
+typedef struct dd_admission_task
+{
+	uint32_t task_id;
+	uint32_t period;
+	uint32_t execution_time;
+	uint32_t relative_deadline;
+	bool admitted;
+} dd_admission_task_t;
+
+// Periodic tasks seen so far over caller-owned storage of max_length entries.
+// Rejected tasks are kept too, so later releases of the same task are turned
+// away without testing again. The sums only cover admitted tasks.
+typedef struct dd_admission
+{
+	dd_admission_task_t *ptasks;
+	uint32_t length;
+	uint32_t max_length;
+	uint64_t periodic_utilization;		// sum of C / T
+	uint64_t periodic_density;			// sum of C / D
+	uint64_t slack_demand;				// sum of (T - D) * C / T, numerator of the test interval bound
+	uint64_t aperiodic_backlog;			// execution time of the outstanding aperiodic jobs
+	uint32_t min_relative_deadline;
+	uint32_t demand_tests;				// full processor-demand tests run so far
+} dd_admission_t;
+
+void dd_admission_init(dd_admission_t *padmission, dd_admission_task_t *ptasks, uint32_t max_length);
+dd_admission_task_t *pDd_admission_find_task(dd_admission_t *padmission, uint32_t task_id);
+bool dd_admit_periodic_task(dd_admission_t *padmission, uint32_t task_id, uint32_t period, uint32_t execution_time, uint32_t relative_deadline);
+bool dd_remove_periodic_task(dd_admission_t *padmission, uint32_t task_id);
+bool dd_admit_aperiodic_job(dd_admission_t *padmission, uint32_t execution_time, uint32_t relative_deadline);
+void dd_release_aperiodic_job(dd_admission_t *padmission, uint32_t execution_time);
+
+#endif /* DD_ADMISSION_H */
@@ -0,0 +1,62 @@
+/* Standard includes. */
+#include <stdint.h>
+
+#include "stm32f4xx.h"
+#include "../FreeRTOS_Source/include/FreeRTOS.h"
+
+#include "dd_cycles.h"
+
+// The CMSIS core_cm4.h in Libraries/ predates the DWT register definitions,
+// so the two registers used here are addressed directly (ARMv7-M ARM, C1.8)
+#define dwtCTRL								(*(volatile uint32_t *)0xE0001000UL)
+#define dwtCYCCNT							(*(volatile uint32_t *)0xE0001004UL)
+#define dwtCTRL_CYCCNTENA					0x00000001UL
+
+// CYCCNT is 32 bits and wraps every ~25 s at 168 MHz. It is extended to 64 bits
+// here, which only holds while it is read at least once per wrap; every context
+// switch reads it, so the tick alone keeps it well inside that.
+static uint32_t cycle_count_high = 0;
+static uint32_t cycle_count_last = 0;
+
+void dd_cycle_counter_init(void)
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	dwtCYCCNT = 0;
+	dwtCTRL |= dwtCTRL_CYCCNTENA;
+	cycle_count_high = 0;
+	cycle_count_last = 0;
+}
+
+// Safe from tasks, interrupts and the kernel trace hooks
+uint64_t ullDd_cycle_count(void)
+{
+	UBaseType_t saved_interrupt_mask;
+	uint32_t cycle_count_low;
+	uint64_t cycle_count;
+
+	saved_interrupt_mask = portSET_INTERRUPT_MASK_FROM_ISR();
+
+	cycle_count_low = dwtCYCCNT;
+
+	if(cycle_count_low < cycle_count_last)
+	{
+		cycle_count_high++;
+	}
+
+	cycle_count_last = cycle_count_low;
+	cycle_count = ((uint64_t)cycle_count_high << 32) | cycle_count_low;
+
+	portCLEAR_INTERRUPT_MASK_FROM_ISR(saved_interrupt_mask);
+
+	return cycle_count;
+}
+
+uint32_t ulDd_cycles_to_us(uint64_t cycles)
+{
+	return (uint32_t)(cycles / ulDd_cycles_per_us());
+}
+
+uint32_t ulDd_cycles_per_us(void)
+{
+	return SystemCoreClock / 1000000UL;
+}
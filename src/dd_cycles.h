@@ -0,0 +1,17 @@
+/*
+ * Free-running cycle counter used to account the CPU time of DD tasks.
+ * On the STM32F4 it is the Cortex-M4 DWT cycle counter (SystemCoreClock Hz),
+ * the host build replaces it with CLOCK_MONOTONIC nanoseconds (Host/dd_cycles.c).
+ */
+
+#ifndef DD_CYCLES_H
+#define DD_CYCLES_H
+
+#include <stdint.h>
+
+void dd_cycle_counter_init(void);
+uint64_t ullDd_cycle_count(void);
+uint32_t ulDd_cycles_to_us(uint64_t cycles);
+uint32_t ulDd_cycles_per_us(void);
+
+#endif /* DD_CYCLES_H */
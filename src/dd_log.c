@@ -0,0 +1,266 @@
+/* Standard includes. */
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "../FreeRTOS_Source/include/FreeRTOS.h"
+#include "../FreeRTOS_Source/include/task.h"
+
+#include "dd_log.h"
+
+// Longest piece of a message printed in one printf call, text before a
+// conversion plus the conversion itself
+#define logSEGMENT_LENGTH					64
+
+// Type printf reads for a conversion, the stored word is cast back to it
+typedef enum log_argument
+{
+	LOG_ARGUMENT_NONE,						// "%%" or the end of the format
+	LOG_ARGUMENT_INT,
+	LOG_ARGUMENT_UNSIGNED,
+	LOG_ARGUMENT_LONG,
+	LOG_ARGUMENT_UNSIGNED_LONG,
+	LOG_ARGUMENT_POINTER,
+	LOG_ARGUMENT_STRING
+} log_argument_t;
+
+#if (logRING_LENGTH & (logRING_LENGTH - 1)) != 0
+#error "logRING_LENGTH must be a power of two"
+#endif
+
+dd_ring_t dd_log_ring;
+static dd_log_entry_t log_ring_entries[logRING_LENGTH];
+static uint32_t log_ring_sequences[logRING_LENGTH];
+
+// Set by the DDLog task once it runs, messages written before are kept in the ring
+static TaskHandle_t log_task_handle = NULL;
+static uint32_t log_drain_pending = 0;
+
+void dd_log_init(void)
+{
+	dd_ring_init(&dd_log_ring, log_ring_entries, log_ring_sequences, sizeof(dd_log_entry_t), logRING_LENGTH);
+	log_drain_pending = 0;
+}
+
+// Skip flags, width and length of the conversion that starts at the '%' in
+// *ppcharacter, leaves *ppcharacter on the conversion character
+static log_argument_t scan_conversion(const char **ppcharacter)
+{
+	const char *pcharacter = *ppcharacter;
+	bool long_length = false;
+
+	do
+	{
+		pcharacter++;
+		long_length = long_length || (*pcharacter == 'l');
+	} while(((*pcharacter >= '0') && (*pcharacter <= '9')) || (*pcharacter == '-') || (*pcharacter == '.') || (*pcharacter == 'l'));
+
+	*ppcharacter = pcharacter;
+
+	switch(*pcharacter)
+	{
+		case '\0':
+		case '%':
+			return LOG_ARGUMENT_NONE;
+		case 'd':
+		case 'i':
+			return long_length ? LOG_ARGUMENT_LONG : LOG_ARGUMENT_INT;
+		case 'c':
+			return LOG_ARGUMENT_INT;
+		case 'p':
+			return LOG_ARGUMENT_POINTER;
+		case 's':
+			return LOG_ARGUMENT_STRING;
+		default:
+			return long_length ? LOG_ARGUMENT_UNSIGNED_LONG : LOG_ARGUMENT_UNSIGNED;
+	}
+}
+
+// Store a message for the DDLog task. The format is only scanned for its
+// conversions, so the arguments can be taken with the type printf will read.
+void dd_log_write(const char *pformat, ...)
+{
+	dd_log_entry_t entry;
+	const char *pcharacter;
+	uint32_t count = 0;
+	va_list arguments;
+
+	entry.pformat = pformat;
+	va_start(arguments, pformat);
+
+	for(pcharacter = pformat; (*pcharacter != '\0') && (count < logMAX_ARGUMENTS); pcharacter++)
+	{
+		if(*pcharacter != '%')
+		{
+			continue;
+		}
+
+		switch(scan_conversion(&pcharacter))
+		{
+			case LOG_ARGUMENT_NONE:
+				break;
+			case LOG_ARGUMENT_INT:
+				entry.arguments[count++] = (uintptr_t)va_arg(arguments, int);
+				break;
+			case LOG_ARGUMENT_LONG:
+				entry.arguments[count++] = (uintptr_t)va_arg(arguments, long);
+				break;
+			case LOG_ARGUMENT_UNSIGNED_LONG:
+				entry.arguments[count++] = (uintptr_t)va_arg(arguments, unsigned long);
+				break;
+			case LOG_ARGUMENT_POINTER:
+				entry.arguments[count++] = (uintptr_t)va_arg(arguments, void *);
+				break;
+			case LOG_ARGUMENT_STRING:
+				entry.arguments[count++] = (uintptr_t)va_arg(arguments, const char *);
+				break;
+			default:
+				entry.arguments[count++] = (uintptr_t)va_arg(arguments, unsigned int);
+				break;
+		}
+
+		if(*pcharacter == '\0')
+		{
+			break;
+		}
+	}
+
+	va_end(arguments);
+
+	if(!dd_ring_push(&dd_log_ring, &entry))
+	{
+		return;
+	}
+
+	// One notification per drain, however many messages arrive meanwhile
+	if((log_task_handle != NULL) && !__atomic_exchange_n(&log_drain_pending, 1, __ATOMIC_ACQ_REL))
+	{
+		xTaskNotifyGive(log_task_handle);
+	}
+}
+
+static void flush_log_segment(char *psegment, uint32_t *plength)
+{
+	if(*plength > 0)
+	{
+		psegment[*plength] = '\0';
+		printf("%s", psegment);
+		*plength = 0;
+	}
+}
+
+// Print a deferred message one conversion at a time, so every argument goes
+// back to printf with the type its conversion reads
+static void dd_log_print(const dd_log_entry_t *pentry)
+{
+	char segment[logSEGMENT_LENGTH];
+	const char *pcharacter = pentry->pformat;
+	const char *pconversion;
+	log_argument_t type;
+	uintptr_t argument;
+	uint32_t length = 0;
+	uint32_t count = 0;
+
+	while(*pcharacter != '\0')
+	{
+		if(*pcharacter != '%')
+		{
+			segment[length++] = *pcharacter++;
+
+			if(length == logSEGMENT_LENGTH - 1)
+			{
+				flush_log_segment(segment, &length);
+			}
+
+			continue;
+		}
+
+		pconversion = pcharacter;
+		type = scan_conversion(&pconversion);
+
+		if(*pconversion == '%')
+		{
+			flush_log_segment(segment, &length);
+			printf("%%");
+			pcharacter = pconversion + 1;
+			continue;
+		}
+
+		// A conversion past the stored arguments has nothing to print
+		if((type == LOG_ARGUMENT_NONE) || (count == logMAX_ARGUMENTS) || (pconversion - pcharacter + 1 >= logSEGMENT_LENGTH))
+		{
+			break;
+		}
+
+		if(length + (pconversion - pcharacter + 1) >= logSEGMENT_LENGTH)
+		{
+			flush_log_segment(segment, &length);
+		}
+
+		while(pcharacter <= pconversion)
+		{
+			segment[length++] = *pcharacter++;
+		}
+
+		segment[length] = '\0';
+		argument = pentry->arguments[count++];
+
+		switch(type)
+		{
+			case LOG_ARGUMENT_INT:
+				printf(segment, (int)argument);
+				break;
+			case LOG_ARGUMENT_LONG:
+				printf(segment, (long)argument);
+				break;
+			case LOG_ARGUMENT_UNSIGNED_LONG:
+				printf(segment, (unsigned long)argument);
+				break;
+			case LOG_ARGUMENT_POINTER:
+				printf(segment, (void *)argument);
+				break;
+			case LOG_ARGUMENT_STRING:
+				printf(segment, (const char *)argument);
+				break;
+			default:
+				printf(segment, (unsigned int)argument);
+				break;
+		}
+
+		length = 0;
+	}
+
+	flush_log_segment(segment, &length);
+}
+
+// Execute the DDLog task, formats the deferred messages oldest first.
+// The flag is cleared before draining, so a message written during the
+// drain either is printed by it or gives a new notification.
+void dd_log_task(void *pvParameters)
+{
+	dd_log_entry_t entry;
+	uint32_t overflows;
+	uint32_t reported_overflows = 0;
+
+	log_task_handle = xTaskGetCurrentTaskHandle();
+
+	while(1)
+	{
+		__atomic_store_n(&log_drain_pending, 0, __ATOMIC_SEQ_CST);
+
+		while(dd_ring_pop(&dd_log_ring, &entry))
+		{
+			dd_log_print(&entry);
+		}
+
+		overflows = __atomic_load_n(&(dd_log_ring.overflows), __ATOMIC_RELAXED);
+
+		if(overflows != reported_overflows)
+		{
+			printf("dd_log_task: %u messages dropped, the log ring was full\n", (unsigned int)(overflows - reported_overflows));
+			reported_overflows = overflows;
+		}
+
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+	}
+}
@@ -0,0 +1,83 @@
+/*
+ * Logging for the DD scheduler and its tasks with compile-time level filtering.
+ * A message above logLEVEL compiles to nothing, its arguments are not even
+ * evaluated. With logDEFERRED set an enabled message only stores its format
+ * pointer and arguments in a dd_ring, which masks interrupts for the few
+ * instructions of a push but never blocks, and the DDLog task formats it with
+ * printf later at the lowest task priority. Otherwise it is printed in place.
+ *
+ * Deferred messages may be written from any task but not from an interrupt.
+ * Their %s arguments must still be valid when the message is printed, e.g.
+ * string literals. Every other argument is stored as one machine word and
+ * passed back to printf with the type its conversion reads.
+ */
+
+#ifndef DD_LOG_H
+#define DD_LOG_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "dd_ring.h"
+
+#define logLEVEL_NONE						0
+#define logLEVEL_ERROR						1
+#define logLEVEL_WARN						2
+#define logLEVEL_INFO						3
+#define logLEVEL_DEBUG						4
+
+#ifndef logLEVEL
+	#define logLEVEL						logLEVEL_INFO
+#endif
+
+#ifndef logDEFERRED
+	#define logDEFERRED						1
+#endif
+
+#define logRING_LENGTH						32					// power of two
+#define logMAX_ARGUMENTS					6
+
+#if logDEFERRED != 0
+	#define logWRITE(...)					dd_log_write(__VA_ARGS__)
+#else
+	#define logWRITE(...)					printf(__VA_ARGS__)
+#endif
+
+#if logLEVEL >= logLEVEL_ERROR
+	#define logERROR(...)					logWRITE(__VA_ARGS__)
+#else
+	#define logERROR(...)					do { } while(0)
+#endif
+
+#if logLEVEL >= logLEVEL_WARN
+	#define logWARN(...)					logWRITE(__VA_ARGS__)
+#else
+	#define logWARN(...)					do { } while(0)
+#endif
+
+#if logLEVEL >= logLEVEL_INFO
+	#define logINFO(...)					logWRITE(__VA_ARGS__)
+#else
+	#define logINFO(...)					do { } while(0)
+#endif
+
+#if logLEVEL >= logLEVEL_DEBUG
+	#define logDEBUG(...)					logWRITE(__VA_ARGS__)
+#else
+	#define logDEBUG(...)					do { } while(0)
+#endif
+
+typedef struct dd_log_entry
+{
+	const char *pformat;
+	uintptr_t arguments[logMAX_ARGUMENTS];
+} dd_log_entry_t;
+
+// Deferred messages, dd_log_ring.overflows counts the dropped ones
+extern dd_ring_t dd_log_ring;
+
+void dd_log_init(void);
+void dd_log_write(const char *pformat, ...) __attribute__((format(printf, 1, 2)));
+void dd_log_task(void *pvParameters);
+
+#endif /* DD_LOG_H */
@@ -0,0 +1,40 @@
+/* Standard includes. */
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../FreeRTOS_Source/include/FreeRTOS.h"
+
+#include "dd_memory.h"
+
+#if ( configUSE_HEAP_HINTS == 1 )
+
+// CCM RAM left after .ccmbss, from stm32f4_flash.ld
+extern uint8_t _sccmheap[];
+extern uint8_t _eccmheap[];
+
+// The DMA reachable region, in SRAM
+static uint8_t sram_heap[configTOTAL_HEAP_SIZE];
+
+void dd_memory_init(void)
+{
+	// heap_5 takes the regions in address order, CCM (0x10000000) is below
+	// SRAM (0x20000000). It keeps no pointer to the array.
+	HeapRegion_t heap_regions[] =
+	{
+		{ _sccmheap, 0, pdTRUE },
+		{ sram_heap, sizeof(sram_heap), pdFALSE },
+		{ NULL, 0, pdFALSE }
+	};
+
+	heap_regions[0].xSizeInBytes = (size_t)(_eccmheap - _sccmheap);
+	vPortDefineHeapRegions(heap_regions);
+}
+
+#else
+
+// heap_4 or heap_6 manage their own array
+void dd_memory_init(void)
+{
+}
+
+#endif /* configUSE_HEAP_HINTS */
@@ -0,0 +1,21 @@
+/*
+ * Memory placement on the STM32F407. Its 64 KB of core coupled memory (CCM)
+ * is zero wait state and only the CPU reaches it, so it never contends with a
+ * DMA transfer on the bus matrix, and no DMA controller can use it. The DD
+ * scheduler bookkeeping is placed there with DD_CCM_DATA, and the rest of CCM
+ * is a CPU only region of the FreeRTOS heap (heap_5 with configUSE_HEAP_HINTS),
+ * where the kernel puts its TCBs, stacks, queues and timers. DMA buffers must
+ * come from pvPortMallocWithHint(size, portHEAP_HINT_DMA), which only returns
+ * SRAM.
+ */
+
+#ifndef DD_MEMORY_H
+#define DD_MEMORY_H
+
+// Zero initialized data in CCM RAM, the .ccmbss section of stm32f4_flash.ld
+#define DD_CCM_DATA							__attribute__((section(".ccmbss")))
+
+// Gives the heap regions to heap_5, before anything calls pvPortMalloc()
+void dd_memory_init(void);
+
+#endif /* DD_MEMORY_H */
@@ -0,0 +1,78 @@
+/* Standard includes. */
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "dd_pool.h"
+
+void dd_pool_init(dd_pool_t *ppool)
+{
+	uint32_t index;
+
+	for(index = 0; index < ppool->length; index++)
+	{
+		ppool->pnext_free[index] = (uint16_t)(index + 1);
+	}
+
+	ppool->free_head = 0;
+	ppool->in_use = 0;
+	ppool->high_water_mark = 0;
+	ppool->alloc_failures = 0;
+}
+
+// Pop the top of the free stack, O(1) and lock-free so it is safe from any task or ISR
+void *pvDd_pool_alloc(dd_pool_t *ppool)
+{
+	uint32_t old_head;
+	uint32_t new_head;
+	uint32_t index;
+	uint32_t in_use;
+	uint32_t high_water_mark;
+
+	old_head = __atomic_load_n(&(ppool->free_head), __ATOMIC_ACQUIRE);
+
+	do
+	{
+		index = old_head & poolINDEX_MASK;
+
+		if(index >= ppool->length)
+		{
+			__atomic_add_fetch(&(ppool->alloc_failures), 1, __ATOMIC_RELAXED);
+			return NULL;
+		}
+
+		new_head = ((old_head & ~poolINDEX_MASK) + poolTAG_INCREMENT) | ppool->pnext_free[index];
+	} while(!__atomic_compare_exchange_n(&(ppool->free_head), &old_head, new_head, true, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+
+	in_use = __atomic_add_fetch(&(ppool->in_use), 1, __ATOMIC_RELAXED);
+	high_water_mark = __atomic_load_n(&(ppool->high_water_mark), __ATOMIC_RELAXED);
+
+	while((in_use > high_water_mark) && !__atomic_compare_exchange_n(&(ppool->high_water_mark), &high_water_mark, in_use, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+	{
+	}
+
+	return (void *)(ppool->pstorage + (index * ppool->element_size));
+}
+
+// Push the element back on the free stack
+void dd_pool_free(dd_pool_t *ppool, void *pelement)
+{
+	uint32_t old_head;
+	uint32_t new_head;
+	uint32_t index;
+
+	if(pelement == NULL)
+	{
+		return;
+	}
+
+	index = (uint32_t)(((uint8_t *)pelement - ppool->pstorage) / ppool->element_size);
+	old_head = __atomic_load_n(&(ppool->free_head), __ATOMIC_RELAXED);
+
+	do
+	{
+		ppool->pnext_free[index] = (uint16_t)(old_head & poolINDEX_MASK);
+		new_head = ((old_head & ~poolINDEX_MASK) + poolTAG_INCREMENT) | index;
+	} while(!__atomic_compare_exchange_n(&(ppool->free_head), &old_head, new_head, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+
+	__atomic_sub_fetch(&(ppool->in_use), 1, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,34 @@
+/*
+ * Fixed-capacity pools of equally sized elements over caller-owned storage,
+ * used by the DD scheduler for its task descriptors and list nodes and shared
+ * with the host test in Host/dds_pool.c. Free elements are linked by index
+ * into a lock-free stack, so allocating and freeing are O(1) and safe from any
+ * task or ISR. free_head packs a 16-bit ABA tag above the 16-bit index of the
+ * top element (index == length when the pool is empty).
+ */
+
+#ifndef DD_POOL_H
+#define DD_POOL_H
+
+#include <stdint.h>
+
+#define poolINDEX_MASK						0xFFFFUL
+#define poolTAG_INCREMENT					0x10000UL
+
+typedef struct dd_pool
+{
+	uint8_t *pstorage;
+	uint16_t *pnext_free;
+	uint32_t element_size;
+	uint32_t length;
+	volatile uint32_t free_head;
+	volatile uint32_t in_use;
+	volatile uint32_t high_water_mark;
+	volatile uint32_t alloc_failures;
+} dd_pool_t;
+
+void dd_pool_init(dd_pool_t *ppool);
+void *pvDd_pool_alloc(dd_pool_t *ppool);
+void dd_pool_free(dd_pool_t *ppool, void *pelement);
+
+#endif /* DD_POOL_H */
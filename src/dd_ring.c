@@ -0,0 +1,92 @@
+/* Standard includes. */
+#include <stddef.h>
+#include <string.h>
+
+#include "../FreeRTOS_Source/include/FreeRTOS.h"
+
+#include "dd_ring.h"
+
+void dd_ring_init(dd_ring_t *pring, void *pelements, uint32_t *psequences, uint32_t element_size, uint32_t length)
+{
+	uint32_t index;
+
+	configASSERT((length != 0) && ((length & (length - 1)) == 0));
+
+	pring->pelements = (uint8_t *)pelements;
+	pring->psequences = psequences;
+	pring->element_size = element_size;
+	pring->length = length;
+
+	for(index = 0; index < length; index++)
+	{
+		psequences[index] = index;
+	}
+
+	pring->enqueue_position = 0;
+	pring->dequeue_position = 0;
+	pring->overflows = 0;
+}
+
+// Claim the next free slot and publish a copy of the element in it, never blocks.
+// Returns false when the ring is full.
+bool dd_ring_push(dd_ring_t *pring, const void *pelement)
+{
+	uint32_t index;
+	uint32_t position;
+	int32_t difference;
+	UBaseType_t saved_interrupt_mask;
+
+	saved_interrupt_mask = portSET_INTERRUPT_MASK_FROM_ISR();
+	position = __atomic_load_n(&(pring->enqueue_position), __ATOMIC_RELAXED);
+
+	while(1)
+	{
+		index = position & (pring->length - 1);
+		difference = (int32_t)(__atomic_load_n(&(pring->psequences[index]), __ATOMIC_ACQUIRE) - position);
+
+		if(difference == 0)
+		{
+			if(__atomic_compare_exchange_n(&(pring->enqueue_position), &position, position + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+			{
+				break;
+			}
+		}
+		else if(difference < 0)
+		{
+			// The slot still holds an element from one lap ago, the ring is full
+			__atomic_add_fetch(&(pring->overflows), 1, __ATOMIC_RELAXED);
+			portCLEAR_INTERRUPT_MASK_FROM_ISR(saved_interrupt_mask);
+			return false;
+		}
+		else
+		{
+			// Another producer claimed this slot first
+			position = __atomic_load_n(&(pring->enqueue_position), __ATOMIC_RELAXED);
+		}
+	}
+
+	memcpy(&(pring->pelements[index * pring->element_size]), pelement, pring->element_size);
+	__atomic_store_n(&(pring->psequences[index]), position + 1, __ATOMIC_RELEASE);
+	portCLEAR_INTERRUPT_MASK_FROM_ISR(saved_interrupt_mask);
+
+	return true;
+}
+
+// Take the oldest published element, only called by the consumer task. A slot
+// that is claimed but not yet published stops the drain, which can only be an
+// interrupt above configMAX_SYSCALL_INTERRUPT_PRIORITY, and those may not push.
+bool dd_ring_pop(dd_ring_t *pring, void *pelement)
+{
+	uint32_t index = pring->dequeue_position & (pring->length - 1);
+
+	if((int32_t)(__atomic_load_n(&(pring->psequences[index]), __ATOMIC_ACQUIRE) - (pring->dequeue_position + 1)) < 0)
+	{
+		return false;
+	}
+
+	memcpy(pelement, &(pring->pelements[index * pring->element_size]), pring->element_size);
+	__atomic_store_n(&(pring->psequences[index]), pring->dequeue_position + pring->length, __ATOMIC_RELEASE);
+	pring->dequeue_position++;
+
+	return true;
+}
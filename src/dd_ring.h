@@ -0,0 +1,36 @@
+/*
+ * Bounded lock-free ring of fixed-size elements over caller-owned storage,
+ * shared by the DD scheduler event ring and the deferred log. Any task or ISR
+ * may push, a push never blocks and fails when the ring is full. Only one task
+ * pops.
+ *
+ * A producer claims a slot by advancing enqueue_position with a compare-and-swap
+ * and publishes it through the slot sequence: the slot is free for position p
+ * when its sequence is p and holds an element when its sequence is p + 1. Claim
+ * and publish run with interrupts masked up to configMAX_SYSCALL_INTERRUPT_PRIORITY,
+ * so a producer is never preempted holding a claimed slot, which would stop the
+ * consumer's drain behind a task of any priority.
+ */
+
+#ifndef DD_RING_H
+#define DD_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct dd_ring
+{
+	uint8_t *pelements;					// length elements of element_size bytes
+	uint32_t *psequences;				// one per element
+	uint32_t element_size;
+	uint32_t length;					// power of two
+	volatile uint32_t enqueue_position;
+	uint32_t dequeue_position;
+	volatile uint32_t overflows;		// pushes that found the ring full
+} dd_ring_t;
+
+void dd_ring_init(dd_ring_t *pring, void *pelements, uint32_t *psequences, uint32_t element_size, uint32_t length);
+bool dd_ring_push(dd_ring_t *pring, const void *pelement);
+bool dd_ring_pop(dd_ring_t *pring, void *pelement);
+
+#endif /* DD_RING_H */
@@ -0,0 +1,187 @@
+/* Standard includes. */
+#include <stddef.h>
+#include <string.h>
+
+#include "dd_task.h"
+
+static void swap_heap_entries(dd_task_heap_t *pheap, uint32_t first_index, uint32_t second_index)
+{
+	dd_task_info_t *ptemp = pheap->pentries[first_index];
+
+	pheap->pentries[first_index] = pheap->pentries[second_index];
+	pheap->pentries[second_index] = ptemp;
+	pheap->pentries[first_index]->heap_index = first_index;
+	pheap->pentries[second_index]->heap_index = second_index;
+}
+
+// Move the entry at heap_index towards the root until its parent has an earlier deadline
+static void sift_heap_up(dd_task_heap_t *pheap, uint32_t heap_index)
+{
+	uint32_t parent_index;
+
+	while(heap_index > 0)
+	{
+		parent_index = (heap_index - 1) / 2;
+
+		if(!deadline_is_earlier(pheap->pentries[heap_index], pheap->pentries[parent_index]))
+		{
+			break;
+		}
+
+		swap_heap_entries(pheap, heap_index, parent_index);
+		heap_index = parent_index;
+	}
+}
+
+// Move the entry at heap_index towards the leaves until both children have later deadlines
+static void sift_heap_down(dd_task_heap_t *pheap, uint32_t heap_index)
+{
+	uint32_t child_index;
+
+	while((child_index = (2 * heap_index) + 1) < pheap->length)
+	{
+		if(((child_index + 1) < pheap->length) && deadline_is_earlier(pheap->pentries[child_index + 1], pheap->pentries[child_index]))
+		{
+			child_index++;
+		}
+
+		if(!deadline_is_earlier(pheap->pentries[child_index], pheap->pentries[heap_index]))
+		{
+			break;
+		}
+
+		swap_heap_entries(pheap, heap_index, child_index);
+		heap_index = child_index;
+	}
+}
+
+// Insert is O(log n), returns false when the heap storage is full
+bool dd_heap_insert(dd_task_heap_t *pheap, dd_task_info_t *ptask_info)
+{
+	if(pheap->length >= pheap->max_length)
+	{
+		return false;
+	}
+
+	pheap->pentries[pheap->length] = ptask_info;
+	ptask_info->heap_index = pheap->length;
+	pheap->length++;
+	sift_heap_up(pheap, pheap->length - 1);
+
+	return true;
+}
+
+dd_task_info_t *pDd_heap_peek(dd_task_heap_t *pheap)
+{
+	if(pheap->length == 0)
+	{
+		return NULL;
+	}
+
+	return pheap->pentries[0];
+}
+
+dd_task_info_t *pDd_heap_remove(dd_task_heap_t *pheap, uint32_t heap_index)
+{
+	dd_task_info_t *premoved;
+
+	if(heap_index >= pheap->length)
+	{
+		return NULL;
+	}
+
+	premoved = pheap->pentries[heap_index];
+	premoved->heap_index = heapINDEX_NONE;
+	pheap->length--;
+
+	if(heap_index != pheap->length)
+	{
+		// Fill the hole with the last entry and restore the heap order around it
+		pheap->pentries[heap_index] = pheap->pentries[pheap->length];
+		pheap->pentries[heap_index]->heap_index = heap_index;
+
+		if((heap_index > 0) && deadline_is_earlier(pheap->pentries[heap_index], pheap->pentries[(heap_index - 1) / 2]))
+		{
+			sift_heap_up(pheap, heap_index);
+		}
+		else
+		{
+			sift_heap_down(pheap, heap_index);
+		}
+	}
+
+	pheap->pentries[pheap->length] = NULL;
+
+	return premoved;
+}
+
+// Remove a task through its own heap_index, O(log n) with no search.
+// Returns false when the task is not in this heap.
+bool dd_heap_remove_task(dd_task_heap_t *pheap, dd_task_info_t *ptask_info)
+{
+	uint32_t heap_index = ptask_info->heap_index;
+
+	if((heap_index >= pheap->length) || (pheap->pentries[heap_index] != ptask_info))
+	{
+		return false;
+	}
+
+	pDd_heap_remove(pheap, heap_index);
+
+	return true;
+}
+
+// Publishing a snapshot is begin, one append per task, end. Only the DD
+// scheduler writes a snapshot, so the writer side needs no lock and never waits.
+void dd_snapshot_begin(dd_task_snapshot_t *psnapshot)
+{
+	__atomic_store_n(&(psnapshot->sequence), psnapshot->sequence + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	psnapshot->length = 0;
+}
+
+void dd_snapshot_append(dd_task_snapshot_t *psnapshot, dd_task_info_t *ptask_info)
+{
+	if(psnapshot->length < psnapshot->max_length)
+	{
+		psnapshot->pentries[psnapshot->length++] = *ptask_info;
+	}
+}
+
+void dd_snapshot_end(dd_task_snapshot_t *psnapshot)
+{
+	__atomic_store_n(&(psnapshot->sequence), psnapshot->sequence + 1, __ATOMIC_RELEASE);
+}
+
+// Copy the last published snapshot into ptask_infos and return its length,
+// retried until no publish overlapped the copy
+uint32_t dd_snapshot_read(dd_task_snapshot_t *psnapshot, dd_task_info_t *ptask_infos, uint32_t max_length)
+{
+	uint32_t sequence;
+	uint32_t length;
+
+	while(1)
+	{
+		sequence = __atomic_load_n(&(psnapshot->sequence), __ATOMIC_ACQUIRE);
+
+		if(sequence & 1)
+		{
+			continue;
+		}
+
+		length = psnapshot->length;
+
+		if(length > max_length)
+		{
+			length = max_length;
+		}
+
+		memcpy(ptask_infos, psnapshot->pentries, length * sizeof(dd_task_info_t));
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+		if(__atomic_load_n(&(psnapshot->sequence), __ATOMIC_RELAXED) == sequence)
+		{
+			return length;
+		}
+	}
+}
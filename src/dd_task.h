@@ -0,0 +1,142 @@
+/*
+ * Deadline-Driven task model shared by the DD scheduler in main.c and the
+ * host discrete-event simulator in Host/dds_sim.c.
+ */
+
+#ifndef DD_TASK_H
+#define DD_TASK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "../FreeRTOS_Source/include/FreeRTOS.h"
+#include "../FreeRTOS_Source/include/task.h"
+
+// What the DD scheduler does with a job whose deadline has passed
+// -	OVERRUN_CONTINUE: the job finishes at background priority
+// -	OVERRUN_ABORT: the job is cancelled, it stops at its next cancellation point
+// -	OVERRUN_SKIP_NEXT: the job finishes at background priority and the next
+//	release of its periodic task is skipped to give it that time
+typedef enum dd_overrun_policy
+{
+	OVERRUN_CONTINUE,
+	OVERRUN_ABORT,
+	OVERRUN_SKIP_NEXT
+} dd_overrun_policy_t;
+
+// Deadline-Driven task data structure
+typedef enum task_type
+{
+	UNDEFINED,
+	PERIODIC,
+	APERIODIC
+} task_type_t;
+
+typedef enum task_state
+{
+	TASK_ACTIVE,
+	TASK_COMPLETED,
+	TASK_OVERDUE,
+	TASK_RETIRED
+} task_state_t;
+
+// Row of a const periodic task-set table. Every job of the task is released
+// offset + k * period ticks after start-up and is due relative_deadline ticks
+// after its release; job_function runs it on a DD worker and may use led.
+typedef struct dd_periodic_task
+{
+	uint32_t task_id;
+	uint32_t period;
+	uint32_t execution_time;
+	uint32_t offset;
+	uint32_t relative_deadline;
+	uint32_t led;
+	TaskFunction_t job_function;
+} dd_periodic_task_t;
+
+typedef struct dd_task_info
+{
+	TaskHandle_t task_handle;
+	TaskFunction_t job_function;
+	const dd_periodic_task_t *pperiodic_task;
+	task_type_t type;
+	task_state_t state;
+	bool job_outstanding;
+	// Set by the scheduler under OVERRUN_ABORT, polled by the job function
+	volatile bool abort_requested;
+	uint32_t task_id;
+	uint32_t release_time;
+	uint32_t completion_time;
+	uint32_t overdue_time;
+	uint32_t absolute_deadline;
+	uint32_t execution_time;
+	uint32_t period;
+	uint32_t relative_deadline;
+	uint32_t heap_index;
+	// Execution-time accounting in dd_cycles.h counter cycles, kept by the
+	// worker and the kernel trace hooks so time spent preempted is not counted
+	uint64_t release_cycle;
+	uint64_t completion_cycle;
+	uint64_t switch_in_cycle;
+	uint64_t execution_cycles;
+	uint32_t preemption_count;
+} dd_task_info_t;
+
+typedef struct dd_task_node
+{
+	dd_task_info_t *pnode;
+	struct dd_task_node *pnext_node;
+} dd_task_node_t;
+
+// Completed and overdue DD tasks are kept oldest first and bounded to max_length,
+// the oldest entry is retired back to the pools when a new one is appended
+typedef struct dd_task_list
+{
+	dd_task_node_t *phead;
+	dd_task_node_t *ptail;
+	uint32_t length;
+	uint32_t max_length;
+} dd_task_list_t;
+
+// Binary min-heap of DD tasks ordered by absolute deadline over caller-owned
+// storage of max_length entries, pentries[0] is always the earliest deadline.
+// Every task in the heap keeps its own position in heap_index so it can be
+// removed without a search, heapINDEX_NONE once it has left the heap.
+#define heapINDEX_NONE						0xFFFFFFFFUL
+
+typedef struct dd_task_heap
+{
+	dd_task_info_t **pentries;
+	uint32_t length;
+	uint32_t max_length;
+} dd_task_heap_t;
+
+// Copy of a DD task list published by the DD scheduler for the monitor.
+// Guarded by a sequence lock: the scheduler never waits to publish, a reader
+// retries its copy when a publish overlapped it (odd sequence = publishing).
+typedef struct dd_task_snapshot
+{
+	dd_task_info_t *pentries;
+	uint32_t max_length;
+	uint32_t length;
+	volatile uint32_t sequence;
+} dd_task_snapshot_t;
+
+// Deadlines are tick counts, compare them through the signed difference so the
+// ordering survives the tick counter wrapping around
+static inline bool deadline_is_earlier(dd_task_info_t *pfirst, dd_task_info_t *psecond)
+{
+	return ((int32_t)(pfirst->absolute_deadline - psecond->absolute_deadline) < 0);
+}
+
+bool dd_heap_insert(dd_task_heap_t *pheap, dd_task_info_t *ptask_info);
+dd_task_info_t *pDd_heap_peek(dd_task_heap_t *pheap);
+dd_task_info_t *pDd_heap_remove(dd_task_heap_t *pheap, uint32_t heap_index);
+bool dd_heap_remove_task(dd_task_heap_t *pheap, dd_task_info_t *ptask_info);
+
+void dd_snapshot_begin(dd_task_snapshot_t *psnapshot);
+void dd_snapshot_append(dd_task_snapshot_t *psnapshot, dd_task_info_t *ptask_info);
+void dd_snapshot_end(dd_task_snapshot_t *psnapshot);
+uint32_t dd_snapshot_read(dd_task_snapshot_t *psnapshot, dd_task_info_t *ptask_infos, uint32_t max_length);
+
+#endif /* DD_TASK_H */
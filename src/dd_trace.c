@@ -0,0 +1,50 @@
+/* Standard includes. */
+#include <stddef.h>
+#include <string.h>
+
+#include "dd_cycles.h"
+#include "dd_trace.h"
+
+// The header is valid from start-up, so tasks created before dd_trace_init() are recorded too
+dd_trace_t dd_trace =
+{
+	.magic = traceMAGIC,
+	.version = traceVERSION,
+	.record_size = sizeof(dd_trace_record_t),
+	.ring_length = traceRING_LENGTH,
+	.cycles_per_us = 0,
+	.task_name_length = traceTASK_NAME_LENGTH,
+	.head = 0,
+	.reserved = 0
+};
+
+void dd_trace_init(void)
+{
+	dd_trace.cycles_per_us = ulDd_cycles_per_us();
+}
+
+void dd_trace_record(dd_trace_event_t event, uint32_t task, uint32_t argument)
+{
+	uint32_t claim = __atomic_fetch_add(&(dd_trace.head), 1, __ATOMIC_RELAXED);
+	dd_trace_record_t *precord = &(dd_trace.ring[claim & (traceRING_LENGTH - 1)]);
+
+	__atomic_store_n(&(precord->sequence), 0, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	precord->timestamp = ullDd_cycle_count();
+	precord->argument = argument;
+	precord->task = (uint16_t)task;
+	precord->event = (uint8_t)event;
+	__atomic_store_n(&(precord->sequence), claim + 1, __ATOMIC_RELEASE);
+}
+
+// Called through traceTASK_CREATE, keeps the name of every kernel task number
+// outside the ring so it survives the ring wrapping
+void dd_trace_task_created(uint32_t task, const char *pname)
+{
+	if(task < traceMAX_TASKS)
+	{
+		strncpy(dd_trace.task_names[task], pname, traceTASK_NAME_LENGTH - 1);
+	}
+
+	dd_trace_record(TRACE_TASK_CREATE, task, 0);
+}
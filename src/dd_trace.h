@@ -0,0 +1,77 @@
+/*
+ * Binary event recorder for the FreeRTOS trace macros and the DD scheduler.
+ * Every event is a fixed-size timestamped record written into a lock-free RAM
+ * ring that keeps the newest traceRING_LENGTH events. The whole dd_trace
+ * object is the dump format: read it out with a debugger (or on exit of the
+ * host build) and convert it with Host/dds_trace.c.
+ */
+
+#ifndef DD_TRACE_H
+#define DD_TRACE_H
+
+#include <stdint.h>
+
+#define traceMAGIC							0x52544444UL		// "DDTR"
+#define traceVERSION						1
+// Readers take the ring length from the dump header, a build may raise it
+#ifndef traceRING_LENGTH
+#define traceRING_LENGTH					512					// power of two
+#endif
+#define traceMAX_TASKS						16
+#define traceTASK_NAME_LENGTH				12
+
+typedef enum dd_trace_event
+{
+	// FreeRTOS trace macros, task is the kernel task number
+	TRACE_TASK_CREATE = 1,
+	TRACE_TASK_SWITCHED_IN,
+	TRACE_TASK_SWITCHED_OUT,
+	TRACE_TASK_PRIORITY_SET,				// argument = new priority
+	TRACE_TIMER_EXPIRED,
+	// DD scheduler events, task is the DD task id
+	TRACE_DD_RELEASE,						// argument = absolute deadline
+	TRACE_DD_COMPLETE,						// argument = completion tick
+	TRACE_DD_OVERDUE,						// argument = overdue tick
+	TRACE_DD_REJECT,						// argument = execution time
+	TRACE_DD_DISPATCH						// argument = kernel task number of the worker handed the job
+} dd_trace_event_t;
+
+typedef struct dd_trace_record
+{
+	uint64_t timestamp;						// dd_cycles.h counter
+	uint32_t sequence;						// claim index + 1 once the record is complete
+	uint32_t argument;
+	uint16_t task;
+	uint8_t event;
+	uint8_t reserved[5];
+} dd_trace_record_t;
+
+// Any context may record, including interrupts and the kernel trace hooks: a
+// writer claims the next slot with one atomic increment of head and publishes
+// it by storing its sequence last. A record that was being written when the
+// dump was taken does not carry the sequence of its slot and is skipped.
+typedef struct dd_trace
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t record_size;
+	uint32_t ring_length;
+	uint32_t cycles_per_us;
+	uint32_t task_name_length;
+	volatile uint32_t head;
+	uint32_t reserved;
+	char task_names[traceMAX_TASKS][traceTASK_NAME_LENGTH];
+	dd_trace_record_t ring[traceRING_LENGTH];
+} dd_trace_t;
+
+#if (traceRING_LENGTH & (traceRING_LENGTH - 1)) != 0
+#error "traceRING_LENGTH must be a power of two"
+#endif
+
+extern dd_trace_t dd_trace;
+
+void dd_trace_init(void);
+void dd_trace_record(dd_trace_event_t event, uint32_t task, uint32_t argument);
+void dd_trace_task_created(uint32_t task, const char *pname);
+
+#endif /* DD_TRACE_H */
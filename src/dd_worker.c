@@ -0,0 +1,109 @@
+/* Standard includes. */
+#include <stddef.h>
+
+#include "dd_worker.h"
+#include "dd_trace.h"
+
+// Queue a job until a worker frees up, behind every pending job due no later
+// than it so equal deadlines keep their release order
+static void queue_pending_job(dd_worker_pool_t *ppool, dd_task_info_t *ptask_info)
+{
+	uint32_t index = ppool->pending_count;
+
+	// Sized by the caller so that a queued job is never dropped
+	configASSERT(ppool->pending_count < ppool->max_pending);
+
+	while((index > 0) && deadline_is_earlier(ptask_info, ppool->ppending_jobs[index - 1]))
+	{
+		ppool->ppending_jobs[index] = ppool->ppending_jobs[index - 1];
+		index--;
+	}
+
+	ppool->ppending_jobs[index] = ptask_info;
+	ppool->pending_count++;
+}
+
+// Take the earliest deadline pending job that is still active. A late job only
+// gets a worker once no active job waits for one, it would run at the lowest
+// priority while an active job with a later deadline stayed queued.
+static dd_task_info_t *pTake_pending_job(dd_worker_pool_t *ppool)
+{
+	dd_task_info_t *ptask_info;
+	uint32_t taken = 0;
+	uint32_t index;
+
+	if(ppool->pending_count == 0)
+	{
+		return NULL;
+	}
+
+	while((taken < ppool->pending_count) && (ppool->ppending_jobs[taken]->state != TASK_ACTIVE))
+	{
+		taken++;
+	}
+
+	if(taken == ppool->pending_count)
+	{
+		taken = 0;
+	}
+
+	ptask_info = ppool->ppending_jobs[taken];
+	ppool->pending_count--;
+
+	for(index = taken; index < ppool->pending_count; index++)
+	{
+		ppool->ppending_jobs[index] = ppool->ppending_jobs[index + 1];
+	}
+
+	return ptask_info;
+}
+
+void dd_worker_add_idle(dd_worker_pool_t *ppool, TaskHandle_t worker_handle)
+{
+	configASSERT(ppool->idle_count < ppool->max_workers);
+
+	ppool->pidle_workers[ppool->idle_count++] = worker_handle;
+}
+
+bool dd_worker_dispatch(dd_worker_pool_t *ppool, dd_task_info_t *ptask_info)
+{
+	TaskHandle_t worker_handle;
+
+	if(ppool->idle_count == 0)
+	{
+		queue_pending_job(ppool, ptask_info);
+		return false;
+	}
+
+	worker_handle = ppool->pidle_workers[--ppool->idle_count];
+	ptask_info->task_handle = worker_handle;
+
+#if configUSE_EDF_SCHEDULING == 1
+	// The kernel runs the earliest deadline worker of the execution priority by
+	// itself, a job that went overdue while it waited for a worker runs at the lowest
+	vTaskSetDeadline(worker_handle, ptask_info->absolute_deadline);
+	vTaskPrioritySet(worker_handle, (ptask_info->state == TASK_ACTIVE) ? ppool->execution_priority : ppool->lowest_priority);
+#endif
+
+	dd_trace_record(TRACE_DD_DISPATCH, ptask_info->task_id, uxTaskGetTaskNumber(worker_handle));
+
+	xTaskNotify(worker_handle, (uint32_t)(ptask_info - ppool->ptask_infos), eSetValueWithOverwrite);
+
+	return true;
+}
+
+dd_task_info_t *pDd_worker_release(dd_worker_pool_t *ppool, TaskHandle_t worker_handle)
+{
+	dd_task_info_t *pnext_job;
+
+	dd_worker_add_idle(ppool, worker_handle);
+
+	pnext_job = pTake_pending_job(ppool);
+
+	if(pnext_job != NULL)
+	{
+		(void) dd_worker_dispatch(ppool, pnext_job);
+	}
+
+	return pnext_job;
+}
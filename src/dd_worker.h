@@ -0,0 +1,39 @@
+/*
+ * Hand-off of released DD jobs to a pool of pre-spawned worker tasks, used by
+ * the DD scheduler in main.c and timed by Host/dds_release.c. Idle workers
+ * block on their task notification and receive the index of the job's task
+ * info in ptask_infos. Jobs released while every worker is busy wait in the
+ * pending queue, sorted by absolute deadline with the earliest first. Only
+ * one task, the DD scheduler, may use a pool, so it needs no lock.
+ */
+
+#ifndef DD_WORKER_H
+#define DD_WORKER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "dd_task.h"
+
+typedef struct dd_worker_pool
+{
+	TaskHandle_t *pidle_workers;		// stack of max_workers idle worker handles
+	uint32_t max_workers;
+	uint32_t idle_count;
+	dd_task_info_t **ppending_jobs;		// max_pending jobs waiting for a worker
+	uint32_t max_pending;
+	uint32_t pending_count;
+	dd_task_info_t *ptask_infos;		// jobs are handed over as their index in it
+	UBaseType_t execution_priority;
+	UBaseType_t lowest_priority;
+} dd_worker_pool_t;
+
+// Return a worker to the idle stack, also how workers join the pool at start-up
+void dd_worker_add_idle(dd_worker_pool_t *ppool, TaskHandle_t worker_handle);
+// Hand a released job to an idle worker, true, or queue it until one frees up, false
+bool dd_worker_dispatch(dd_worker_pool_t *ppool, dd_task_info_t *ptask_info);
+// Free the worker of a finished job and hand it the next pending job, which
+// is returned, NULL when no job waits
+dd_task_info_t *pDd_worker_release(dd_worker_pool_t *ppool, TaskHandle_t worker_handle);
+
+#endif /* DD_WORKER_H */
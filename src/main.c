@@ -17,6 +17,16 @@
 #include "../FreeRTOS_Source/include/task.h"
 #include "../FreeRTOS_Source/include/timers.h"
 
+#include "dd_task.h"
+#include "dd_cycles.h"
+#include "dd_admission.h"
+#include "dd_trace.h"
+#include "dd_log.h"
+#include "dd_memory.h"
+#include "dd_ring.h"
+#include "dd_pool.h"
+#include "dd_worker.h"
+
 /*-----------------------------------------------------------*/
 // Hardware defines
 #define amber_led   						LED3
@@ -32,10 +42,18 @@
 # define TASK_GENERATOR_PRIORITY      				4
 # define TASK_SCHEDULER_PRIORITY      				5
 
-#define schedulerQUEUE_LENGTH					20
-#define monitorQUEUE_LENGTH 					3
-#define taskgeneratorQUEUE_LENGTH				3
-#define taskQUEUE_LENGTH					1
+#define schedulerRING_LENGTH					32
+#define monitorPERIOD						1000
+#define activeHEAP_LENGTH					32
+#define completedLIST_LENGTH					8
+#define overdueLIST_LENGTH					8
+#define taskinfoPOOL_LENGTH					(activeHEAP_LENGTH + completedLIST_LENGTH + overdueLIST_LENGTH)
+#define tasknodePOOL_LENGTH					(completedLIST_LENGTH + overdueLIST_LENGTH)
+#define workerPOOL_LENGTH					4
+// Every job waiting for a worker holds a task info, active or overdue, so a
+// pending queue as long as the task info pool can never overflow
+#define pendingQUEUE_LENGTH					taskinfoPOOL_LENGTH
+#define admissionTASK_LENGTH					periodicTASK_COUNT
 
 #define TASK1_ID						1
 #define TASK2_ID						2
@@ -50,59 +68,103 @@
 #define TASK_1_PERIOD						9000
 #define TASK_2_PERIOD						5000
 #define TASK_3_PERIOD						7500
-#define APERIODIC_TASK_PERIOD					3000
-
-#define	TASK_1_TIMER						1
-#define	TASK_2_TIMER						2
-#define	TASK_3_TIMER						3
-#define	APERIODIC_TASK_TIMER					4
-
-// Deadline-Driven task data structure
-typedef enum task_type
-{
-	UNDEFINED,
-	PERIODIC,
-	APERIODIC
-} task_type_t;
-
-typedef struct dd_task_info
-{
-	TaskHandle_t task_handle;
-	TimerHandle_t timer_handle;
-	task_type_t type;
-	uint32_t task_id;
-	uint32_t release_time;
-	uint32_t completion_time;
-	uint32_t overdue_time;
-	uint32_t absolute_deadline;
-} dd_task_info_t;
 
-typedef struct dd_task_node
-{
-	dd_task_info_t *pnode;
-	struct dd_task_node *pnext_node;
-} dd_task_node_t;
-
-dd_task_node_t *pActive_list_head = NULL;
-dd_task_node_t *pCompletion_list_head = NULL;
-dd_task_node_t *pOverdue_list_head = NULL;
+#if (configUSE_EDF_SCHEDULING == 1) && (configEDF_PRIORITY != TASK_EXECUTION_PRIORITY)
+#error "configEDF_PRIORITY must be TASK_EXECUTION_PRIORITY, the priority of the dispatched DD workers"
+#endif
+
+// The kernel silently caps a higher priority at configMAX_PRIORITIES - 1, which
+// would put the DD scheduler in the same band as the generator
+#if TASK_SCHEDULER_PRIORITY >= configMAX_PRIORITIES
+#error "configMAX_PRIORITIES must be above TASK_SCHEDULER_PRIORITY"
+#endif
+
+// Aperiodic DD tasks are served by a Total Bandwidth Server on top of EDF.
+// An aperiodic job of execution time C released at r gets the deadline
+// max(r, previous aperiodic deadline) + C / serverBANDWIDTH, so aperiodic load
+// never takes more than serverBANDWIDTH of the processor. EDF then meets every
+// deadline as long as the periodic utilization leaves that bandwidth free.
+#define serverBANDWIDTH_PERCENT					25
+
+// What the DD scheduler does with every job whose deadline passes, see dd_overrun_policy_t.
+// An aborted job's worker is raised to TASK_EXECUTION_PRIORITY until the job
+// reaches its next cancellation point, so the CPU is reclaimed within a time slice.
+#define overrunPOLICY						OVERRUN_CONTINUE
+
+// Emulated job execution in percent of the declared execution time. Admission
+// control only sees the declared time, above 100 every job overruns it and the
+// late jobs keep their workers, the overload case of make -C Host ordering.
+#ifndef jobEXECUTION_PERCENT
+#define jobEXECUTION_PERCENT					100
+#endif
+
+// Periodic DD task set, one row per task, all times in ticks:
+//	X(task id, period, execution time, offset, relative deadline, LED, job function)
+// Adding a periodic task is adding a row, the release task serves every row
+#define PERIODIC_TASK_SET(X) \
+	X(TASK1_ID,	TASK_1_PERIOD,	TASK_1_EXECUTION_TIME,	0,	TASK_1_PERIOD,	amber_led,	dd_user_defined_led_task) \
+	X(TASK2_ID,	TASK_2_PERIOD,	TASK_2_EXECUTION_TIME,	0,	TASK_2_PERIOD,	green_led,	dd_user_defined_led_task) \
+	X(TASK3_ID,	TASK_3_PERIOD,	TASK_3_EXECUTION_TIME,	0,	TASK_3_PERIOD,	blue_led,	dd_user_defined_led_task)
+
+#define periodicTASK_ROW(id, period, wcet, offset, deadline, led, job)		{ id, period, wcet, offset, deadline, led, job },
+#define periodicTASK_ONE(id, period, wcet, offset, deadline, led, job)		+ 1
+#define periodicTASK_DENSITY(id, period, wcet, offset, deadline, led, job)	+ ((((wcet) * 10000) + (deadline) - 1) / (deadline))
+
+#define periodicTASK_COUNT					(0 PERIODIC_TASK_SET(periodicTASK_ONE))
+#define periodicDENSITY_PER_10000				(0 PERIODIC_TASK_SET(periodicTASK_DENSITY))
+
+#if (periodicDENSITY_PER_10000 + (serverBANDWIDTH_PERCENT * 100)) > 10000
+#error "Periodic density plus serverBANDWIDTH_PERCENT exceeds 100%, EDF cannot guarantee the periodic deadlines"
+#endif
+
+// Active DD tasks are kept in a binary min-heap ordered by absolute deadline,
+// pActive_task_heap[0] is always the task with the earliest deadline. The
+// scheduler bookkeeping is only touched by the CPU, it lives in CCM RAM
+// (dd_memory.h) with the pools, snapshots and admission state below
+DD_CCM_DATA dd_task_info_t *pActive_task_heap[activeHEAP_LENGTH];
+dd_task_heap_t active_task_heap = { pActive_task_heap, 0, activeHEAP_LENGTH };
+
+dd_task_list_t completed_task_list = { NULL, NULL, 0, completedLIST_LENGTH };
+dd_task_list_t overdue_task_list = { NULL, NULL, 0, overdueLIST_LENGTH };
+
+// Snapshots of the three lists, republished by the scheduler whenever a list
+// changes and read by the monitor without going through the scheduler
+static DD_CCM_DATA dd_task_info_t active_snapshot_storage[activeHEAP_LENGTH];
+static DD_CCM_DATA dd_task_info_t completed_snapshot_storage[completedLIST_LENGTH];
+static DD_CCM_DATA dd_task_info_t overdue_snapshot_storage[overdueLIST_LENGTH];
+
+dd_task_snapshot_t active_task_snapshot = { active_snapshot_storage, activeHEAP_LENGTH, 0, 0 };
+dd_task_snapshot_t completed_task_snapshot = { completed_snapshot_storage, completedLIST_LENGTH, 0, 0 };
+dd_task_snapshot_t overdue_task_snapshot = { overdue_snapshot_storage, overdueLIST_LENGTH, 0, 0 };
+
+// DD task descriptors and list nodes come from fixed-capacity dd_pools
+static DD_CCM_DATA dd_task_info_t task_info_pool_storage[taskinfoPOOL_LENGTH];
+static DD_CCM_DATA uint16_t task_info_pool_next_free[taskinfoPOOL_LENGTH];
+static DD_CCM_DATA dd_task_node_t task_node_pool_storage[tasknodePOOL_LENGTH];
+static DD_CCM_DATA uint16_t task_node_pool_next_free[tasknodePOOL_LENGTH];
+
+dd_pool_t task_info_pool = { (uint8_t *)task_info_pool_storage, task_info_pool_next_free, sizeof(dd_task_info_t), taskinfoPOOL_LENGTH, 0, 0, 0, 0 };
+dd_pool_t task_node_pool = { (uint8_t *)task_node_pool_storage, task_node_pool_next_free, sizeof(dd_task_node_t), tasknodePOOL_LENGTH, 0, 0, 0, 0 };
 
 typedef enum dd_message_type
 {
 	RELEASE_TASK = 0,
 	COMPLETED_TASK,
-	GET_ACTIVE_DD_TASK_LIST,
-	GET_COMPLETED_DD_TASK_LIST,
-	GET_OVERDUE_DD_TASK_lIST
+	OVERDUE_TASK
 } dd_message_type_t;
 
 typedef struct dd_message
 {
 	dd_message_type_t message_type;
 	dd_task_info_t *ptask_info;
-	dd_task_node_t *ptask_list;
 } dd_message_t;
 
+// Scheduler messages go through a dd_ring, any task or ISR may post and only
+// the DD scheduler reads
+#if (schedulerRING_LENGTH & (schedulerRING_LENGTH - 1)) != 0
+#error "schedulerRING_LENGTH must be a power of two"
+#endif
+
 /*
  * TODO: Implement this function for any hardware specific clock configuration
  * that was not already performed before main() was called.
@@ -112,60 +174,136 @@ static void prvSetupHardware(void);
 static void dd_task_scheduler(void *pvParameters);
 static void dd_task_monitor(void *pvParameters);
 
-static void dd_task_generator_1(void *pvParameters);
-static void dd_task_generator_2(void *pvParameters);
-static void dd_task_generator_3(void *pvParameters);
+static void dd_task_release(void *pvParameters);
+
+static void vDeadlineTimerCallBack(xTimerHandle xTimer);
 
-static void vTaskTimerCallBack(xTimerHandle xTimer);
+static void dd_worker_task(void *pvParameters);
 
-static void dd_user_defined_task_1(void *pvParameters);
-static void dd_user_defined_task_2(void *pvParameters);
-static void dd_user_defined_task_3(void *pvParameters);
+static void dd_user_defined_led_task(void *pvParameters);
+static void dd_user_defined_aperiodic_task(void *pvParameters);
+static void emulate_dd_task_execution(dd_task_info_t *ptask_info);
 
 // functions declaration
+void post_scheduler_message(dd_message_type_t message_type, dd_task_info_t *ptask_info);
+BaseType_t post_scheduler_message_from_isr(dd_message_type_t message_type, dd_task_info_t *ptask_info, BaseType_t *pxHigherPriorityTaskWoken);
+void init_dd_task_info(dd_task_info_t *ptask_info, TaskHandle_t task_handle, task_type_t type, uint32_t task_id, uint32_t absolute_deadline);
 dd_task_info_t *pCreate_dd_task_info(TaskHandle_t task_handle, task_type_t type, uint32_t task_id, uint32_t absolute_deadline);
 void delete_dd_task_info(dd_task_info_t *ptask_info);
+uint32_t dd_task_info_index(dd_task_info_t *ptask_info);
+dd_task_info_t *pDd_task_info_from_index(uint32_t index);
+void dispatch_dd_task_to_worker(dd_task_info_t *ptask_info);
+void release_dd_task_worker(dd_task_info_t *ptask_info);
+void dispatch_earliest_deadline_task(void);
+dd_task_info_t *pEarliest_deadline_task_with_worker(void);
+void apply_overrun_policy(dd_task_info_t *ptask_info);
+void hasten_aborted_job(dd_task_info_t *ptask_info);
+void arm_deadline_timer(void);
+void retire_dd_task_info(dd_task_info_t *ptask_info);
 void release_dd_task_info(dd_task_info_t *ptask_info);
+BaseType_t release_dd_task_from_isr(dd_task_info_t *ptask_info, BaseType_t *pxHigherPriorityTaskWoken);
+BaseType_t release_aperiodic_dd_task_from_isr(uint32_t task_id, uint32_t execution_time, TaskFunction_t job_function, BaseType_t *pxHigherPriorityTaskWoken);
+void assign_aperiodic_deadline(dd_task_info_t *ptask_info);
+bool admit_dd_task(dd_task_info_t *ptask_info);
 void dd_task_completed(dd_task_info_t *ptask_info);
-dd_task_node_t **pGetActiveDDTaskList(void);
-dd_task_node_t **pGetCompletedDDTaskList(void);
-dd_task_node_t **pGetOverdueDDTaskList(void);
-
-dd_task_node_t *insert_new_node_to_active_list(dd_task_info_t *ptask_info);
+BaseType_t dd_task_completed_from_isr(dd_task_info_t *ptask_info, BaseType_t *pxHigherPriorityTaskWoken);
+void publish_active_snapshot(void);
+void publish_task_list_snapshot(dd_task_snapshot_t *psnapshot, dd_task_list_t *ptask_list);
+uint32_t get_active_dd_task_list(dd_task_info_t *ptask_infos, uint32_t max_length);
+uint32_t get_completed_dd_task_list(dd_task_info_t *ptask_infos, uint32_t max_length);
+uint32_t get_overdue_dd_task_list(dd_task_info_t *ptask_infos, uint32_t max_length);
+
+bool insert_task_to_active_heap(dd_task_info_t *ptask_info);
+dd_task_info_t *pPeek_earliest_deadline_task(void);
+dd_task_info_t *pRemove_task_from_active_heap(uint32_t heap_index);
+dd_task_node_t *insert_new_node_to_task_list(dd_task_list_t *ptask_list, dd_task_info_t *ptask_info);
 dd_task_node_t *insert_new_node_to_completed_list(dd_task_info_t *ptask_info);
 dd_task_node_t *insert_new_node_to_overdue_list(dd_task_info_t *ptask_info);
 uint32_t active_list_length();
-void sort_active_list_by_deadline(dd_task_info_t *ptask_info);
-dd_task_node_t *pFind_completed_task_node_by_time_stamp(dd_task_info_t *ptask_info);
-//dd_task_node_t *pFind_completed_task_node_by_time_stamp(uint32_t time_stamp);
-dd_task_node_t *pFind_overdue_task_node_using_time_stamp(uint32_t time_stamp);
-dd_task_node_t *pRemove_completed_task_node_by_time_stamp(dd_task_info_t *ptask_info);
-//dd_task_node_t *pRemove_overdue_task_node_by_time_stamp(uint32_t time_stamp);
-//dd_task_node_t *pRemove_completed_task_node_by_time_stamp(uint32_t time_stamp);
-void printActiveList();
-void printCompletedList();
-void printOverdueList();
+bool remove_completed_task_from_active_heap(dd_task_info_t *ptask_info);
+dd_task_info_t *pRemove_overdue_task_by_time_stamp(uint32_t time_stamp);
+void printActiveList(dd_task_info_t *ptask_infos, uint32_t length);
+void printCompletedList(dd_task_info_t *ptask_infos, uint32_t length);
+void printOverdueList(dd_task_info_t *ptask_infos, uint32_t length);
+void printPoolStatistics();
 
 void EXTI0_IRQHandler(void);
 
-//QueueHandle_t dd_task_message_queue;
-QueueHandle_t dd_scheduler_message_queue;
-QueueHandle_t dd_monitor_message_queue;
+// Messages to the DD scheduler. Posting one also gives the scheduler's task
+// notification, the scheduler drains every message posted since its last
+// wakeup in one batch.
+dd_ring_t dd_scheduler_event_ring;
+static dd_message_t scheduler_ring_messages[schedulerRING_LENGTH];
+static uint32_t scheduler_ring_sequences[schedulerRING_LENGTH];
+TaskHandle_t dd_task_scheduler_handle = NULL;
+uint32_t scheduler_event_count = 0;
+uint32_t scheduler_wakeup_count = 0;
+// Cycles the DD scheduler spent handling its batches, wakeup to republished lists
+uint64_t scheduler_busy_cycles = 0;
+uint32_t scheduler_max_batch_cycles = 0;
+
+// Periodic DD tasks are admitted on their first release and aperiodic jobs on
+// every release, both by the scheduler before the job enters the active heap
+static DD_CCM_DATA dd_admission_task_t admission_task_storage[admissionTASK_LENGTH];
+dd_admission_t dd_admission;
+uint32_t admission_rejection_count = 0;
+
+// One-shot timer armed to the earliest active deadline, replaces per-tick overdue polling
+TimerHandle_t dd_deadline_timer = NULL;
+bool deadline_timer_armed = false;
+uint32_t armed_deadline = 0;
+
+TaskHandle_t dd_task_release_handle = NULL;
+
+static const dd_periodic_task_t periodic_task_set[periodicTASK_COUNT] =
+{
+	PERIODIC_TASK_SET(periodicTASK_ROW)
+};
+
+// Next release of every row of periodic_task_set, sorted by release time so
+// the release task only ever looks at the head. Only the release task uses it.
+typedef struct dd_release_entry
+{
+	uint32_t release_time;
+	uint32_t task_index;
+} dd_release_entry_t;
+
+dd_release_entry_t release_queue[periodicTASK_COUNT];
+
+// Pre-spawned DD worker tasks, see dd_worker.h. They receive the task info
+// pool index of the job to run. Only the scheduler task uses worker_pool.
+TaskHandle_t dd_worker_handles[workerPOOL_LENGTH];
+TaskHandle_t idle_worker_stack[workerPOOL_LENGTH];
+dd_task_info_t *pPending_job_queue[pendingQUEUE_LENGTH];
+dd_worker_pool_t worker_pool = { idle_worker_stack, workerPOOL_LENGTH, 0, pPending_job_queue, pendingQUEUE_LENGTH, 0,
+	task_info_pool_storage, TASK_EXECUTION_PRIORITY, TASK_LOWEST_PRIORITY };
+
+// DD task each worker is running, NULL while it is idle. A worker's task tag points
+// at its own slot so the kernel trace hooks can account the running job.
+dd_task_info_t *volatile worker_running_job[workerPOOL_LENGTH];
+
+// Worker currently boosted to TASK_EXECUTION_PRIORITY, the one running the head of the active heap
+TaskHandle_t dispatched_worker_handle = NULL;
+
+// Overrun policy statistics, and the periodic tasks whose next release is to be
+// skipped, set by the scheduler and cleared by the release task
+uint32_t overrun_abort_count = 0;
+uint32_t overrun_skipped_releases = 0;
+uint8_t skip_next_release[periodicTASK_COUNT];
 
-TaskHandle_t dd_task_generator_1_handle = NULL;
-TaskHandle_t dd_task_generator_2_handle = NULL;
-TaskHandle_t dd_task_generator_3_handle = NULL;
+// Tickless idle statistics, sleeps entered and tick interrupts they suppressed
+uint32_t tickless_sleep_count = 0;
+uint32_t tickless_suppressed_ticks = 0;
 
-//TaskHandle_t dd_aperiodic_task_generator_handle = NULL;
-//TaskHandle_t user_defined_aperiodic_task_handle = NULL;
-//TimerHandle_t xAperiodicTimer;
-//static void dd_aperiodic_task_generator(void *pvParameters);
-//static void dd_user_defined_aperiodic_task(void *pvParameters);
-//static void vAperiodicTaskTimerCallBack(xTimerHandle xTimer);
+// Deadline given to the last aperiodic DD task by the Total Bandwidth Server
+uint32_t aperiodic_server_deadline = 0;
 
 /*-----------------------------------------------------------*/
 int main(void)
 {
+	// Heap regions first, nothing may call pvPortMalloc() before them
+	dd_memory_init();
+
 	// Configure the system ready to run the demo.  The clock configuration
 	// can be done here if it was not done before main() was called
 	prvSetupHardware();
@@ -184,25 +322,37 @@ int main(void)
 	STM_EVAL_PBInit(BUTTON_USER, BUTTON_MODE_EXTI);
 	NVIC_SetPriority(USER_BUTTON_EXTI_IRQn, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY + 1); // Must be above configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
 
-	printf("Initialize message queue\n\n");
+	// Thread the free lists of the DD task descriptor and list node pools
+	dd_pool_init(&task_info_pool);
+	dd_pool_init(&task_node_pool);
+	dd_admission_init(&dd_admission, admission_task_storage, admissionTASK_LENGTH);
+	dd_log_init();
+
+	logINFO("Initialize message queue\n\n");
 
-	// Create the queues used by the queue send and queue receive tasks.
-	dd_scheduler_message_queue = xQueueCreate(schedulerQUEUE_LENGTH, sizeof(dd_message_t));
-	dd_monitor_message_queue = xQueueCreate(monitorQUEUE_LENGTH, sizeof(dd_message_t));
+	dd_ring_init(&dd_scheduler_event_ring, scheduler_ring_messages, scheduler_ring_sequences, sizeof(dd_message_t), schedulerRING_LENGTH);
+	dd_cycle_counter_init();
+	dd_trace_init();
 
-	// Add to the registry, for the benefit of kernel aware debugging.
-	vQueueAddToRegistry(dd_scheduler_message_queue, "DDSchedulerMessageQueue");
-	vQueueAddToRegistry(dd_monitor_message_queue, "DDMonitorMessageQueue");
+	dd_deadline_timer = xTimerCreate("DeadlineTimer", 1, pdFALSE, NULL, vDeadlineTimerCallBack);
 
-	xTaskCreate(dd_task_scheduler, "DDTaskScheduler", configMINIMAL_STACK_SIZE, NULL, TASK_SCHEDULER_PRIORITY, NULL);
+	xTaskCreate(dd_task_scheduler, "DDTaskScheduler", configMINIMAL_STACK_SIZE, NULL, TASK_SCHEDULER_PRIORITY, &dd_task_scheduler_handle);
 	xTaskCreate(dd_task_monitor, "DDTaskMonitor", configMINIMAL_STACK_SIZE, NULL, TASK_MONITOR_PRIORITY, NULL);
 
-	xTaskCreate(dd_task_generator_1, "DDTaskGenerator1", configMINIMAL_STACK_SIZE, NULL, TASK_GENERATOR_PRIORITY, &dd_task_generator_1_handle);
-	xTaskCreate(dd_task_generator_2, "DDTaskGenerator2", configMINIMAL_STACK_SIZE, NULL, TASK_GENERATOR_PRIORITY, &dd_task_generator_2_handle);
-	xTaskCreate(dd_task_generator_3, "DDTaskGenerator3", configMINIMAL_STACK_SIZE, NULL, TASK_GENERATOR_PRIORITY, &dd_task_generator_3_handle);
-//	//xTaskCreate(dd_aperiodic_task_generator, "DDAperiodicTaskGenerator", configMINIMAL_STACK_SIZE, NULL, DD_TASK_GENERATOR_PRIORITY, &dd_aperiodic_task_generator_handle);
+	xTaskCreate(dd_task_release, "DDRelease", configMINIMAL_STACK_SIZE, NULL, TASK_GENERATOR_PRIORITY, &dd_task_release_handle);
 
-	printf("Done initialized message queue\n\n");
+	for(uint32_t i = 0; i < workerPOOL_LENGTH; i++)
+	{
+		xTaskCreate(dd_worker_task, "DDWorker", configMINIMAL_STACK_SIZE, (void *)&worker_running_job[i], TASK_LOWEST_PRIORITY, &dd_worker_handles[i]);
+		vTaskSetApplicationTaskTag(dd_worker_handles[i], (TaskHookFunction_t)&worker_running_job[i]);
+		dd_worker_add_idle(&worker_pool, dd_worker_handles[i]);
+	}
+
+#if logDEFERRED != 0
+	xTaskCreate(dd_log_task, "DDLog", configMINIMAL_STACK_SIZE * 2, NULL, TASK_LOWEST_PRIORITY, NULL);
+#endif
+
+	logINFO("Done initialized message queue\n\n");
 
 	/* Start the tasks and timer running. */
 	vTaskStartScheduler();
@@ -210,835 +360,1076 @@ int main(void)
 	return 0;
 }
 
+// Post from a task, waits a tick at a time while the ring is full
+void post_scheduler_message(dd_message_type_t message_type, dd_task_info_t *ptask_info)
+{
+	dd_message_t scheduler_message;
+
+	scheduler_message.message_type = message_type;
+	scheduler_message.ptask_info = ptask_info;
+
+	while(!dd_ring_push(&dd_scheduler_event_ring, &scheduler_message))
+	{
+		vTaskDelay(1);
+	}
+
+	xTaskNotifyGive(dd_task_scheduler_handle);
+}
+
+// Post from an ISR, returns pdFAIL instead of waiting when the ring is full
+BaseType_t post_scheduler_message_from_isr(dd_message_type_t message_type, dd_task_info_t *ptask_info, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	dd_message_t scheduler_message;
+
+	scheduler_message.message_type = message_type;
+	scheduler_message.ptask_info = ptask_info;
+
+	if(!dd_ring_push(&dd_scheduler_event_ring, &scheduler_message))
+	{
+		return pdFAIL;
+	}
+
+	vTaskNotifyGiveFromISR(dd_task_scheduler_handle, pxHigherPriorityTaskWoken);
+
+	return pdPASS;
+}
+
 dd_task_info_t *pCreate_dd_task_info(TaskHandle_t task_handle, task_type_t type, uint32_t task_id, uint32_t absolute_deadline)
 {
 	dd_task_info_t *ptask_info;
 
-	ptask_info = (dd_task_info_t*)pvPortMalloc(sizeof(dd_task_info_t));
+	ptask_info = (dd_task_info_t*)pvDd_pool_alloc(&task_info_pool);
 
 	if(ptask_info == NULL)
 	{
-		printf("pCreate_dd_task_info: Error no memory!\n");
+		logERROR("pCreate_dd_task_info: Error task info pool is empty!\n");
+		return NULL;
 	}
 
+	init_dd_task_info(ptask_info, task_handle, type, task_id, absolute_deadline);
+
+	return ptask_info;
+}
+
+void init_dd_task_info(dd_task_info_t *ptask_info, TaskHandle_t task_handle, task_type_t type, uint32_t task_id, uint32_t absolute_deadline)
+{
+	memset(ptask_info, 0, sizeof(dd_task_info_t));
+	ptask_info->state = TASK_ACTIVE;
+	ptask_info->job_outstanding = true;
 	ptask_info->task_handle = task_handle;
 	ptask_info->type = type;
 	ptask_info->task_id = task_id;
 	ptask_info->absolute_deadline = absolute_deadline;
-
-	return ptask_info;
+	ptask_info->heap_index = heapINDEX_NONE;
 }
 
 void delete_dd_task_info(dd_task_info_t *ptask_info)
 {
-	vPortFree((void *)ptask_info);
+	dd_pool_free(&task_info_pool, (void *)ptask_info);
 }
 
-// release_dd_task
-// -	receives all info to create a new dd_task struct excluding release time and completion time
-// -	packages dd_task struct as a message and send to a queue (xQueueSend(dd_task))
-// DD Scheduler receives this message from the queue (xQueueReceive(dd_task))
-void release_dd_task_info(dd_task_info_t *ptask_info)
+// Drop a DD task that is no longer kept on any list. An overdue task may still
+// be running on its worker, its info is then freed when the job completes.
+void retire_dd_task_info(dd_task_info_t *ptask_info)
 {
-	dd_message_t scheduler_message;
+	if(ptask_info->job_outstanding)
+	{
+		ptask_info->state = TASK_RETIRED;
+	}
+	else
+	{
+		delete_dd_task_info(ptask_info);
+	}
+}
 
-	scheduler_message.message_type = RELEASE_TASK;
-	scheduler_message.ptask_info = ptask_info;
-	xQueueSend(dd_scheduler_message_queue, (void *)&scheduler_message, portMAX_DELAY);
+// Task infos live in task_info_pool_storage, so the pool index is a compact
+// handle that fits in a task notification value
+uint32_t dd_task_info_index(dd_task_info_t *ptask_info)
+{
+	return (uint32_t)(ptask_info - task_info_pool_storage);
 }
 
-// complete_dd_task
-// - 	receive task ID of DD task that has completed execution
-// - 	package task ID as a message and send to a queue (xQueueSend(task ID))
-// DD Scheduler receives this message from the queue (xQueueReceive(task ID))
-void dd_task_completed(dd_task_info_t *ptask_info)
+dd_task_info_t *pDd_task_info_from_index(uint32_t index)
 {
-	dd_message_t scheduler_message;
+	if(index >= taskinfoPOOL_LENGTH)
+	{
+		return NULL;
+	}
 
-	scheduler_message.message_type = COMPLETED_TASK;
-	scheduler_message.ptask_info = ptask_info;
-	xQueueSend(dd_scheduler_message_queue, (void *)&scheduler_message, portMAX_DELAY);
+	return &task_info_pool_storage[index];
 }
 
-// Execute the dd generator task 1 task
-static void dd_task_generator_1(void *pvParameters)
+// Hand a released DD task to an idle worker, or queue it until one frees up
+void dispatch_dd_task_to_worker(dd_task_info_t *ptask_info)
 {
-	printf("dd_task_generator_1\n");
-	const TickType_t xGeneratorDelay1 = TASK_1_PERIOD;
-	TickType_t current_time;
-
-	while(1)
+	// A job aborted while it waited for a worker still has to reach its cancellation point
+	if(dd_worker_dispatch(&worker_pool, ptask_info) && ptask_info->abort_requested)
 	{
-		//TaskHandle_t user_defined_task_1_handle = NULL;
-		dd_task_info_t *ptask_info_1 = NULL;
-		current_time = xTaskGetTickCount();
-		//dd_message_t scheduler_message;
-		ptask_info_1 = pCreate_dd_task_info(NULL, PERIODIC, TASK1_ID, (current_time + xGeneratorDelay1));
-		xTaskCreate(dd_user_defined_task_1, "DDUserDefinedTask1", configMINIMAL_STACK_SIZE, (void*)ptask_info_1, TASK_LOWEST_PRIORITY, &(ptask_info_1->task_handle));
-		vTaskSuspend(ptask_info_1->task_handle);
-		//BaseType_t returnTaskValue = xTaskCreate(dd_user_defined_task_1, "DDUserDefinedTask1", configMINIMAL_STACK_SIZE, (void*)ptask_info_1, TASK_LOWEST_PRIORITY, &(ptask_info_1->task_handle));
-		//printf("dd_task_generator_1 handle, return task value %d\n", returnTaskValue);
-		//printf("dd_task_generator_1 handle 2\n");
-		printf("dd_task_generator_1 handle = 0x%x: released task!\n", ptask_info_1->task_handle);
-		//scheduler_message.message_type = RELEASE_TASK;
-		//scheduler_message.message_data = ptask_info_1;
-		release_dd_task_info(ptask_info_1);
-		//ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-		//vTaskResume(ptask_info_1->task_handle);
-		vTaskDelay(xGeneratorDelay1);
-		//printf("dd_task_generator_1 handle after delay\n");
+		hasten_aborted_job(ptask_info);
 	}
 }
 
-// Execute the dd generator task 2
-static void dd_task_generator_2(void *pvParameters)
+// Return the worker of a finished DD task to the idle stack, which hands it the
+// earliest deadline pending job
+void release_dd_task_worker(dd_task_info_t *ptask_info)
 {
-	printf("dd_task_generator_2\n");
-	const TickType_t xGeneratorDelay2 = TASK_2_PERIOD;
-	TickType_t current_time;
+	dd_task_info_t *pnext_job;
 
-	while(1)
+	if(ptask_info->task_handle == NULL)
 	{
-		dd_task_info_t *ptask_info_2 = NULL;
-		current_time = xTaskGetTickCount();
-		ptask_info_2 = pCreate_dd_task_info(NULL, PERIODIC, TASK2_ID, (current_time + xGeneratorDelay2));
-		xTaskCreate(dd_user_defined_task_2,	"DDUserDefinedTask2", configMINIMAL_STACK_SIZE,	(void*)ptask_info_2, TASK_LOWEST_PRIORITY, &(ptask_info_2->task_handle));
-		vTaskSuspend(ptask_info_2->task_handle);
-		printf("dd_task_generator_2 handle = 0x%x: released task!\n", ptask_info_2->task_handle);
-		release_dd_task_info(ptask_info_2);
-		vTaskDelay(xGeneratorDelay2);
+		return;
+	}
+
+	if(ptask_info->abort_requested)
+	{
+		vTaskPrioritySet(ptask_info->task_handle, TASK_LOWEST_PRIORITY);
+	}
+
+	pnext_job = pDd_worker_release(&worker_pool, ptask_info->task_handle);
+
+	if((pnext_job != NULL) && pnext_job->abort_requested)
+	{
+		hasten_aborted_job(pnext_job);
 	}
 }
 
-// Execute dd generator task 3
-static void dd_task_generator_3(void *pvParameters)
+// Earliest deadline active DD task that holds a worker, NULL when none does
+dd_task_info_t *pEarliest_deadline_task_with_worker(void)
 {
-	printf("dd_task_generator_3\n");
-	const TickType_t xGeneratorDelay3 = TASK_3_PERIOD;
-	TickType_t current_time;
+	dd_task_info_t *pearliest = NULL;
+	uint32_t index;
 
-	while(1)
+	for(index = 0; index < active_task_heap.length; index++)
 	{
-		dd_task_info_t *ptask_info_3 = NULL;
-		current_time = xTaskGetTickCount();
-		ptask_info_3 = pCreate_dd_task_info(NULL, PERIODIC, TASK3_ID, (current_time + xGeneratorDelay3));
-		xTaskCreate(dd_user_defined_task_3,	"DDUserDefinedTask3", configMINIMAL_STACK_SIZE,	(void*)ptask_info_3, TASK_LOWEST_PRIORITY, &(ptask_info_3->task_handle));
-		vTaskSuspend(ptask_info_3->task_handle);
-		printf("dd_task_generator_3 handle = 0x%x: released task!\n", ptask_info_3->task_handle);
-		release_dd_task_info(ptask_info_3);
-		vTaskDelay(xGeneratorDelay3);
+		if((active_task_heap.pentries[index]->task_handle != NULL) &&
+			((pearliest == NULL) || deadline_is_earlier(active_task_heap.pentries[index], pearliest)))
+		{
+			pearliest = active_task_heap.pentries[index];
+		}
 	}
+
+	return pearliest;
 }
 
-//static void dd_aperiodic_task_generator(void *pvParameters)
-//{
-//	dd_task_info_t *ptask_info = NULL;
-//
-//	while(1)
-//	{
-//		ptask_info = create_dd_task(user_defined_aperiodic_task_handle, APERIODIC, APERIODIC_TASK_ID, APERIODIC_TASK_PERIOD);
-//		xTaskCreate(dd_user_defined_aperiodic_task,	"DDUserDefinedAperiodicTask", configMINIMAL_STACK_SIZE,	NULL, DD_TASK_PRIORITY, user_defined_aperiodic_task_handle);
-//		release_dd_task(ptask_info);
-//		vTaskDelay(pdMS_TO_TICKS(APERIODIC_TASK_PERIOD));
-//	}
-//}
-
-static void vTaskTimerCallBack(xTimerHandle xTimer)
+// EDF dispatch, run by the scheduler after every release, completion and overdue event
+// -	boosts the worker of the earliest deadline DD task to TASK_EXECUTION_PRIORITY,
+//	or while that task waits for a worker, the earliest deadline task that has one
+// -	demotes the previously boosted worker back to TASK_LOWEST_PRIORITY
+// Nothing is changed when the head is still served by the same worker, so a steady
+// head costs no vTaskPrioritySet calls and a head change costs at most two.
+// With configUSE_EDF_SCHEDULING the kernel orders the workers by deadline instead.
+void dispatch_earliest_deadline_task(void)
 {
-	QueueHandle_t dd_task_message_queue_handle = 0;
-	uint32_t timer_id = 0;
+#if configUSE_EDF_SCHEDULING == 0
+
+	dd_task_info_t *pearliest = pPeek_earliest_deadline_task();
+	TaskHandle_t earliest_worker_handle = NULL;
+
+	// Every worker is busy and the head waits for one. The heap order says
+	// nothing about the other tasks, so look through them.
+	if((pearliest != NULL) && (pearliest->task_handle == NULL))
+	{
+		pearliest = pEarliest_deadline_task_with_worker();
+	}
+
+	if(pearliest != NULL)
+	{
+		earliest_worker_handle = pearliest->task_handle;
+	}
+
+	if(earliest_worker_handle == dispatched_worker_handle)
+	{
+		return;
+	}
+
+	if(dispatched_worker_handle != NULL)
+	{
+		vTaskPrioritySet(dispatched_worker_handle, TASK_LOWEST_PRIORITY);
+	}
 
-	dd_task_message_queue_handle = pvTimerGetTimerID(xTimer);
-	//printf("vTaskTimerCallBack: queue handle = 0x%x\n", dd_task_message_queue_handle);
-	xQueueSend(dd_task_message_queue_handle, (void *)&timer_id, (TickType_t)10);
+	if(earliest_worker_handle != NULL)
+	{
+		vTaskPrioritySet(earliest_worker_handle, TASK_EXECUTION_PRIORITY);
+	}
+
+	dispatched_worker_handle = earliest_worker_handle;
+#endif
 }
 
-// Execute dd user-defined task 1
-static void dd_user_defined_task_1(void *pvParameters)
+// Apply overrunPOLICY to a DD task the scheduler just moved to the overdue list
+// -	OVERRUN_ABORT: requests cancellation and hastens the job to its cancellation point
+// -	OVERRUN_SKIP_NEXT: marks the next release of its periodic task to be skipped
+// -	OVERRUN_CONTINUE, and aperiodic jobs under OVERRUN_SKIP_NEXT: nothing to do,
+//	the job keeps running at TASK_LOWEST_PRIORITY
+void apply_overrun_policy(dd_task_info_t *ptask_info)
 {
-	printf("dd_user_defined_task_1\n");
-	dd_task_info_t *pMy_task_info = (dd_task_info_t *)pvParameters;
-	QueueHandle_t dd_task1_message_queue_handle = NULL;
-	//TimerHandle_t xTaskTimer1 = NULL;
-	TaskHandle_t my_task_handle = xTaskGetCurrentTaskHandle();
+	if(overrunPOLICY == OVERRUN_ABORT)
+	{
+		ptask_info->abort_requested = true;
+		overrun_abort_count++;
 
-	TickType_t execution_time1 = 0;
-	TickType_t current_time = 0;
-	uint32_t task_1_id = TASK1_ID;
-	uint32_t *ptimer1_id = 0;
-	uint32_t startTick;
-	uint32_t endTick;
+		if(ptask_info->task_handle != NULL)
+		{
+			hasten_aborted_job(ptask_info);
+		}
+	}
+	else
+	{
+		if((overrunPOLICY == OVERRUN_SKIP_NEXT) && (ptask_info->pperiodic_task != NULL))
+		{
+			__atomic_store_n(&skip_next_release[ptask_info->pperiodic_task - periodic_task_set], 1, __ATOMIC_RELAXED);
+		}
 
-	dd_task1_message_queue_handle = xQueueCreate(taskQUEUE_LENGTH, sizeof(uint32_t));
-	ptimer1_id = dd_task1_message_queue_handle;
-	current_time = xTaskGetTickCount();
-	execution_time1 = current_time + (TASK_1_EXECUTION_TIME/portTICK_PERIOD_MS);
-	pMy_task_info->timer_handle = xTimerCreate("TaskTimer1", execution_time1, pdFALSE, (void *)ptimer1_id, vTaskTimerCallBack);
-	xTimerStart(pMy_task_info->timer_handle, pdMS_TO_TICKS(0));
-	startTick = xTaskGetTickCount();
-	STM_EVAL_LEDOn(amber_led);
-	printf("dd_user_defined_task_1 handle = 0x%x: Amber LED On.\n", (unsigned int)my_task_handle);
+#if configUSE_EDF_SCHEDULING == 1
+		// No head change demotes it, the late job leaves the deadline ordered priority here
+		if(ptask_info->task_handle != NULL)
+		{
+			vTaskPrioritySet(ptask_info->task_handle, TASK_LOWEST_PRIORITY);
+		}
+#endif
+	}
+}
 
-	if(xQueueReceive(dd_task1_message_queue_handle, &task_1_id, portMAX_DELAY) == pdTRUE)
+// Raise the worker of an aborted job next to the earliest deadline worker, a
+// worker left at TASK_LOWEST_PRIORITY could wait behind every other late job
+// before it even sees the request. It is demoted when it returns to the idle stack.
+void hasten_aborted_job(dd_task_info_t *ptask_info)
+{
+	if(ptask_info->task_handle == dispatched_worker_handle)
 	{
-		// wait here until message is receive
+		dispatched_worker_handle = NULL;
 	}
 
-	endTick = xTaskGetTickCount();
-	STM_EVAL_LEDOff(amber_led);
-	printf("dd_user_defined_task_1 handle = 0x%x, tick = %d: Amber LED Off.\n", (unsigned int)my_task_handle, (int)(endTick - startTick));
-	dd_task_completed(pMy_task_info);
-	//xTimerDelete(pMy_task_info->timer_handle, pdMS_TO_TICKS(0));
-	//vQueueDelete(dd_task1_message_queue_handle);
-	//printf("task 1 handle = 0x%x, delete\n", my_task_handle);
-	//vTaskDelete(my_task_handle);
-	//vTaskDelete(NULL);
-	vTaskSuspend(my_task_handle);
-	//vTaskDelayUntil(&startTick, ((pMy_task_info->absolute_deadline) - startTick));
+	vTaskPrioritySet(ptask_info->task_handle, TASK_EXECUTION_PRIORITY);
 }
 
-// Execute dd user-defined task 1
-static void dd_user_defined_task_2(void *pvParameters)
+// Re-arm the deadline timer whenever the earliest active deadline changes.
+// Timer commands are posted without blocking, a failed post leaves the timer
+// marked as unarmed so the next scheduler event retries.
+void arm_deadline_timer(void)
 {
-	printf("dd_user_defined_task_2\n");
-	dd_task_info_t *pMy_task_info = (dd_task_info_t *)pvParameters;
-	QueueHandle_t dd_task2_message_queue_handle = NULL;
-	TaskHandle_t my_task_handle = xTaskGetCurrentTaskHandle();
+	dd_task_info_t *pearliest = pPeek_earliest_deadline_task();
+	TickType_t current_time;
+	TickType_t timer_period;
 
-	//dd_message_t scheduler_message;
-	TickType_t execution_time2 = 0;
-	TickType_t current_time = 0;
-	uint32_t task_2_id = TASK2_ID;
-	uint32_t *ptimer2_id = 0;
-	uint32_t startTick;
-	uint32_t endTick;
+	if(pearliest == NULL)
+	{
+		if(deadline_timer_armed && (xTimerStop(dd_deadline_timer, 0) == pdPASS))
+		{
+			deadline_timer_armed = false;
+		}
+
+		return;
+	}
+
+	if(deadline_timer_armed && (armed_deadline == pearliest->absolute_deadline))
+	{
+		return;
+	}
 
-	dd_task2_message_queue_handle = xQueueCreate(taskQUEUE_LENGTH, sizeof(uint32_t));
-	ptimer2_id = dd_task2_message_queue_handle;
 	current_time = xTaskGetTickCount();
-	execution_time2 = current_time + (TASK_2_EXECUTION_TIME/portTICK_PERIOD_MS);
-	pMy_task_info->timer_handle = xTimerCreate("TaskTimer2", execution_time2, pdFALSE, (void *)ptimer2_id, vTaskTimerCallBack);
-	xTimerStart(pMy_task_info->timer_handle, pdMS_TO_TICKS(0));
-	startTick = xTaskGetTickCount();
-	STM_EVAL_LEDOn(green_led);
-	printf("dd_user_defined_task_2 handle = 0x%x: Green LED On.\n", (unsigned int)my_task_handle);
+	timer_period = 1;
 
-	if(xQueueReceive(dd_task2_message_queue_handle, &task_2_id, portMAX_DELAY) == pdTRUE)
+	if((int32_t)(pearliest->absolute_deadline - current_time) > 0)
 	{
-		// wait here until message is receive
+		timer_period = pearliest->absolute_deadline - current_time;
 	}
 
-	endTick = xTaskGetTickCount();
-	STM_EVAL_LEDOff(green_led);
-	printf("dd_user_defined_task_2 handle = 0x%x, tick = %d: Green LED Off.\n", (unsigned int)my_task_handle, (int)(endTick - startTick));
-	dd_task_completed(pMy_task_info);
-	//vTaskDelete(my_task_handle);
-	vTaskSuspend(my_task_handle);
+	if(xTimerChangePeriod(dd_deadline_timer, timer_period, 0) == pdPASS)
+	{
+		deadline_timer_armed = true;
+		armed_deadline = pearliest->absolute_deadline;
+	}
+	else
+	{
+		deadline_timer_armed = false;
+	}
 }
 
-// Execute dd user-defined task 1
-static void dd_user_defined_task_3(void *pvParameters)
+// Runs in the timer daemon when the earliest deadline passes, the scheduler
+// then moves every expired DD task to the overdue list in one batch
+static void vDeadlineTimerCallBack(xTimerHandle xTimer)
 {
-	printf("dd_user_defined_task_3\n");
-	dd_task_info_t *pMy_task_info = (dd_task_info_t *)pvParameters;
-	QueueHandle_t dd_task3_message_queue_handle = NULL;
-	TaskHandle_t my_task_handle = xTaskGetCurrentTaskHandle();
+	dd_message_t scheduler_message;
 
-	TickType_t execution_time3 = 0;
-	TickType_t current_time = 0;
-	uint32_t task_3_id = TASK3_ID;
-	uint32_t *ptimer3_id = 0;
-	uint32_t startTick;
-	uint32_t endTick;
+	scheduler_message.message_type = OVERDUE_TASK;
+	scheduler_message.ptask_info = NULL;
 
-	dd_task3_message_queue_handle = xQueueCreate(taskQUEUE_LENGTH, sizeof(uint32_t));
-	ptimer3_id = dd_task3_message_queue_handle;
-	current_time = xTaskGetTickCount();
-	execution_time3 = current_time + (TASK_3_EXECUTION_TIME/portTICK_PERIOD_MS);
-	pMy_task_info->timer_handle = xTimerCreate("TaskTimer3", execution_time3, pdFALSE, (void *)ptimer3_id, vTaskTimerCallBack);
-	xTimerStart(pMy_task_info->timer_handle, pdMS_TO_TICKS(0));
-	startTick = xTaskGetTickCount();
-	STM_EVAL_LEDOn(blue_led);
-	printf("dd_user_defined_task_3 handle = 0x%x: Blue LED On.\n", (unsigned int)my_task_handle);
+	if(!dd_ring_push(&dd_scheduler_event_ring, &scheduler_message))
+	{
+		// Scheduler ring is full, try again on the next tick
+		xTimerChangePeriod(xTimer, 1, 0);
+		return;
+	}
 
-	if(xQueueReceive(dd_task3_message_queue_handle, &task_3_id, portMAX_DELAY) == pdTRUE)
+	xTaskNotifyGive(dd_task_scheduler_handle);
+}
+
+// Execute a DD worker task
+// -	waits for the scheduler to notify it with the index of a released DD task
+// -	runs the job function of that DD task and reports its completion
+// -	accounts the CPU time of the job from its first to its last instruction,
+//	the trace hooks stop and restart the count around every preemption
+// Workers are created once at start-up, releasing a DD task never creates a FreeRTOS task
+static void dd_worker_task(void *pvParameters)
+{
+	dd_task_info_t *volatile *prunning_job = (dd_task_info_t *volatile *)pvParameters;
+	uint32_t job_index;
+	dd_task_info_t *ptask_info;
+	uint64_t completion_cycle;
+
+	while(1)
 	{
-		// wait here until message is receive
+		if(xTaskNotifyWait(0, 0xFFFFFFFFUL, &job_index, portMAX_DELAY) == pdTRUE)
+		{
+			ptask_info = pDd_task_info_from_index(job_index);
+
+			if(ptask_info != NULL)
+			{
+				taskENTER_CRITICAL();
+				ptask_info->switch_in_cycle = ullDd_cycle_count();
+				*prunning_job = ptask_info;
+				taskEXIT_CRITICAL();
+
+				ptask_info->job_function((void *)ptask_info);
+
+				taskENTER_CRITICAL();
+				completion_cycle = ullDd_cycle_count();
+				ptask_info->execution_cycles += completion_cycle - ptask_info->switch_in_cycle;
+				ptask_info->completion_cycle = completion_cycle;
+				*prunning_job = NULL;
+				taskEXIT_CRITICAL();
+
+				dd_task_completed(ptask_info);
+			}
+		}
 	}
+}
 
-	endTick = xTaskGetTickCount();
-	STM_EVAL_LEDOff(blue_led);
-	printf("dd_user_defined_task_3 handle = 0x%x, tick = %d: Blue LED Off.\n", (unsigned int)my_task_handle, (int)(endTick - startTick));
-	dd_task_completed(pMy_task_info);
-	vTaskSuspend(my_task_handle);
+// Kernel trace hooks, called from vTaskSwitchContext with the task tag and the
+// TCB number of the task being switched out or in. Every switch is traced, but
+// only DD workers have a tag, and only while their slot holds a job is there
+// anything to account.
+void dd_task_switched_out(void *ptask_tag, uint32_t task_number)
+{
+	dd_task_info_t *ptask_info;
+
+	dd_trace_record(TRACE_TASK_SWITCHED_OUT, task_number, 0);
+
+	if(ptask_tag == NULL)
+	{
+		return;
+	}
+
+	ptask_info = *(dd_task_info_t *volatile *)ptask_tag;
+
+	if(ptask_info != NULL)
+	{
+		ptask_info->execution_cycles += ullDd_cycle_count() - ptask_info->switch_in_cycle;
+		ptask_info->preemption_count++;
+	}
 }
 
-//static void dd_user_defined_aperiodic_task(void *pvParameters)
-//{
-//	TickType_t execution_time = APERIODIC_TASK_EXECUTION_TIME/portTICK_PERIOD_MS;
-//	uint32_t aperiodic_task_id = APERIODIC_TASK_ID;
-//	uint32_t *aperiodictimer_id = NULL;
-//
-//	while(1)
-//	{
-//		if(xQueueReceive(dd_task_message_queue, aperiodictimer_id, pdMS_TO_TICKS(0)) == pdTRUE)
-//		{
-//			break;
-//		}
-//
-//		STM_EVAL_LEDOn(red_led);
-//		printf("Red LED On.\n");
-//		STM_EVAL_LEDOff(red_led);
-//		printf("Red LED Off.\n");
-//	}
-//
-//	xQueueSend(dd_scheduler_message_queue, &aperiodic_task_id, pdMS_TO_TICKS(0));
-//	vTaskDelete(user_defined_aperiodic_task_handle);
-//}
-
-// Push Button Interrupt Handler
-//void EXTI0_IRQHandler(void)
-//{
-//	/* Make sure that interrupt flag is set */
-//	if (EXTI_GetITStatus(EXTI_Line0) != RESET)
-//	{
-//		// Switch an LED
-//		//STM_EVAL_LEDToggle(green_led);
-//		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-//		/* Notify the task that the transmission is complete. */
-//		vTaskNotifyGiveFromISR(user_defined_aperiodic_task_handle, &xHigherPriorityTaskWoken);
-//		/* Clear interrupt flag (Want to do this as late as possible to avoid triggering the IRQ in the IRQ) */
-//		EXTI_ClearITPendingBit(EXTI_Line0);
-//		portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
-//	}
-//}
-
-dd_task_node_t *insert_new_node_to_active_list(dd_task_info_t *ptask_info)
+void dd_task_switched_in(void *ptask_tag, uint32_t task_number)
 {
-	dd_task_node_t *ptemp = (dd_task_node_t*)pvPortMalloc(sizeof(dd_task_node_t)); // create a new node
+	dd_task_info_t *ptask_info;
 
-	ptemp->pnode = ptask_info;
-	ptemp->pnext_node = pActive_list_head;
-	pActive_list_head = ptemp;
+	dd_trace_record(TRACE_TASK_SWITCHED_IN, task_number, 0);
 
-	return ptemp;
+	if(ptask_tag == NULL)
+	{
+		return;
+	}
+
+	ptask_info = *(dd_task_info_t *volatile *)ptask_tag;
+
+	if(ptask_info != NULL)
+	{
+		ptask_info->switch_in_cycle = ullDd_cycle_count();
+	}
 }
 
-dd_task_node_t *insert_new_node_to_completed_list(dd_task_info_t *ptask_info)
+// release_dd_task
+// -	receives all info to create a new dd_task struct excluding release time and completion time
+// -	packages dd_task struct as a message and posts it to the scheduler event ring
+// DD Scheduler drains the ring when its task notification is given
+void release_dd_task_info(dd_task_info_t *ptask_info)
 {
-	dd_task_node_t *ptemp = (dd_task_node_t*)pvPortMalloc(sizeof(dd_task_node_t)); // create a new node
+	post_scheduler_message(RELEASE_TASK, ptask_info);
+}
 
-	ptemp->pnode = ptask_info;
-	ptemp->pnext_node = pCompletion_list_head;
-	pCompletion_list_head = ptemp;
+// release_dd_task_from_isr
+// -	same as release_dd_task but never blocks, pdFAIL when the event ring is full
+BaseType_t release_dd_task_from_isr(dd_task_info_t *ptask_info, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	return post_scheduler_message_from_isr(RELEASE_TASK, ptask_info, pxHigherPriorityTaskWoken);
+}
 
-	return ptemp;
+// release_aperiodic_dd_task_from_isr
+// -	releases an aperiodic DD task from an interrupt, e.g. the user button on EXTI0
+// -	takes its task info from the lock-free pool and posts it without blocking
+// The DD scheduler assigns its deadline through the Total Bandwidth Server on release.
+// Returns pdFAIL when the pool or the scheduler event ring is full, the event is then dropped.
+BaseType_t release_aperiodic_dd_task_from_isr(uint32_t task_id, uint32_t execution_time, TaskFunction_t job_function, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	dd_task_info_t *ptask_info;
+
+	ptask_info = (dd_task_info_t *)pvDd_pool_alloc(&task_info_pool);
+
+	if(ptask_info == NULL)
+	{
+		return pdFAIL;
+	}
+
+	init_dd_task_info(ptask_info, NULL, APERIODIC, task_id, 0);
+	ptask_info->execution_time = execution_time;
+	ptask_info->job_function = job_function;
+
+	if(release_dd_task_from_isr(ptask_info, pxHigherPriorityTaskWoken) != pdPASS)
+	{
+		delete_dd_task_info(ptask_info);
+		return pdFAIL;
+	}
+
+	return pdPASS;
 }
 
-dd_task_node_t *insert_new_node_to_overdue_list(dd_task_info_t *ptask_info)
+// Total Bandwidth Server deadline of an aperiodic DD task, d = max(r, d_prev) + C / U_s.
+// Called by the DD scheduler once the release time is known.
+void assign_aperiodic_deadline(dd_task_info_t *ptask_info)
 {
-	dd_task_node_t *ptemp = (dd_task_node_t*)pvPortMalloc(sizeof(dd_task_node_t)); // create a new node
+	uint32_t server_start = ptask_info->release_time;
 
-	ptemp->pnode = ptask_info;
-	ptemp->pnext_node = pOverdue_list_head;
-	pOverdue_list_head = ptemp;
+	if((int32_t)(aperiodic_server_deadline - server_start) > 0)
+	{
+		server_start = aperiodic_server_deadline;
+	}
 
-	return ptemp;
+	aperiodic_server_deadline = server_start + (((ptask_info->execution_time * 100) + serverBANDWIDTH_PERCENT - 1) / serverBANDWIDTH_PERCENT);
+	ptask_info->absolute_deadline = aperiodic_server_deadline;
+	ptask_info->relative_deadline = aperiodic_server_deadline - ptask_info->release_time;
 }
 
-uint32_t active_list_length()
+// Admission control of a released DD task, called by the DD scheduler
+// -	a periodic task is tested once, on its first release, with the exact EDF
+//	processor-demand test; later releases only look up that decision
+// -	an aperiodic job gets a density check against the periodic task set
+// Returns false when the job would put admitted deadlines at risk, it must then be dropped.
+bool admit_dd_task(dd_task_info_t *ptask_info)
 {
-	uint32_t list_length = 0;
-	dd_task_node_t *pcurrent = NULL;
+	if(ptask_info->type == PERIODIC)
+	{
+		return dd_admit_periodic_task(&dd_admission, ptask_info->task_id, ptask_info->period, ptask_info->execution_time, ptask_info->relative_deadline);
+	}
 
-	for(pcurrent = pActive_list_head; pcurrent != NULL; pcurrent = pcurrent->pnext_node)
+	if(ptask_info->type == APERIODIC)
 	{
-		list_length++;
+		return dd_admit_aperiodic_job(&dd_admission, ptask_info->execution_time, ptask_info->relative_deadline);
 	}
 
-	return list_length;
+	return true;
 }
 
-// sort active_dd_task_list
-// List of DD tasks to be scheduled by the DD scheduler
-// -	Sort the list by deadline every time a DD task is added or removed from the list using selection sort
-// -	Select and implement a data structure and sorting algorithm to sort the list
-// -	Use singly-linked list for sorting
-void sort_active_list_by_deadline(dd_task_info_t *ptask_info)
+// complete_dd_task
+// - 	receive task ID of DD task that has completed execution
+// - 	package task ID as a message and post it to the scheduler event ring
+// DD Scheduler drains the ring when its task notification is given
+void dd_task_completed(dd_task_info_t *ptask_info)
 {
-	dd_task_node_t *pcurrent = NULL;
-	dd_task_node_t *pnext = NULL;
-	dd_task_info_t *ptemp = NULL;
+	post_scheduler_message(COMPLETED_TASK, ptask_info);
+}
+
+// complete_dd_task_from_isr
+// -	same as complete_dd_task but never blocks, pdFAIL when the event ring is full
+BaseType_t dd_task_completed_from_isr(dd_task_info_t *ptask_info, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	return post_scheduler_message_from_isr(COMPLETED_TASK, ptask_info, pxHigherPriorityTaskWoken);
+}
 
-	uint32_t list_size = active_list_length();
-	uint32_t stored_list_size = list_size;
+// Insert an entry into the first length entries of the release queue, after
+// every entry released no later than it so equal release times stay in table order
+static void insert_release_entry(uint32_t length, dd_release_entry_t entry)
+{
+	uint32_t index = length;
 
-	for(int i = 0; i < (list_size - 1); i++, stored_list_size--)
+	while((index > 0) && ((int32_t)(release_queue[index - 1].release_time - entry.release_time) > 0))
 	{
-		pcurrent = pActive_list_head;
-		pnext = pActive_list_head->pnext_node;
+		release_queue[index] = release_queue[index - 1];
+		index--;
+	}
 
-		for(int j = 0; j < stored_list_size; j++)
-		{
-			if((pcurrent->pnode->absolute_deadline) > (ptask_info->absolute_deadline))
-			{
-				ptemp = pcurrent->pnode;
-				pcurrent->pnode = pnext->pnode;
-				pnext->pnode = ptemp;
-			}
+	release_queue[index] = entry;
+}
 
-			pcurrent = pcurrent->pnext_node;
-			pnext = pnext->pnext_node;
-		}
+// Release one job of a periodic DD task, due relative_deadline ticks after its
+// scheduled release time rather than after the tick this task woke up on
+static void release_periodic_dd_task(const dd_periodic_task_t *pperiodic_task, uint32_t release_time)
+{
+	dd_task_info_t *ptask_info;
+
+	ptask_info = pCreate_dd_task_info(NULL, PERIODIC, pperiodic_task->task_id, release_time + pperiodic_task->relative_deadline);
+
+	if(ptask_info == NULL)
+	{
+		return;
 	}
+
+	ptask_info->job_function = pperiodic_task->job_function;
+	ptask_info->pperiodic_task = pperiodic_task;
+	ptask_info->execution_time = pperiodic_task->execution_time;
+	ptask_info->period = pperiodic_task->period;
+	ptask_info->relative_deadline = pperiodic_task->relative_deadline;
+	logDEBUG("dd_task_release task %u, task info = %u: released task!\n", (unsigned int)pperiodic_task->task_id, (unsigned int)dd_task_info_index(ptask_info));
+	release_dd_task_info(ptask_info);
 }
 
-dd_task_node_t *pFind_completed_task_node_by_time_stamp(dd_task_info_t *ptask_info)
+// Execute the DD release task, the one generator of every periodic DD task
+// -	sleeps until the head of the release queue is due
+// -	releases that job and queues the next release of its task one period later
+// Release times advance by whole periods from start-up, so they never drift.
+static void dd_task_release(void *pvParameters)
 {
-	dd_task_node_t *pcurrent = pActive_list_head;
+	TickType_t start_time = xTaskGetTickCount();
+	TickType_t current_time;
+	dd_release_entry_t entry;
+	uint32_t index;
 
-	if(pActive_list_head == NULL)
+	for(index = 0; index < periodicTASK_COUNT; index++)
 	{
-		return NULL;
+		entry.release_time = start_time + periodic_task_set[index].offset;
+		entry.task_index = index;
+		insert_release_entry(index, entry);
 	}
 
-	while(pcurrent->pnode->completion_time != (ptask_info->completion_time))
+	while(1)
 	{
-		if(pcurrent->pnext_node == NULL)
+		current_time = xTaskGetTickCount();
+
+		if((int32_t)(release_queue[0].release_time - current_time) > 0)
 		{
-			return NULL;
+			vTaskDelay(release_queue[0].release_time - current_time);
+			continue;
+		}
+
+		entry = release_queue[0];
+
+		for(index = 1; index < periodicTASK_COUNT; index++)
+		{
+			release_queue[index - 1] = release_queue[index];
+		}
+
+		if(__atomic_exchange_n(&skip_next_release[entry.task_index], 0, __ATOMIC_RELAXED))
+		{
+			overrun_skipped_releases++;
+			logWARN("dd_task_release task %u: release skipped after an overrun\n", (unsigned int)periodic_task_set[entry.task_index].task_id);
 		}
 		else
 		{
-			pcurrent = pcurrent->pnext_node;
+			release_periodic_dd_task(&periodic_task_set[entry.task_index], entry.release_time);
 		}
-	}
 
-	return pcurrent;
+		entry.release_time += periodic_task_set[entry.task_index].period;
+		insert_release_entry(periodicTASK_COUNT - 1, entry);
+	}
 }
 
-dd_task_node_t *pFind_overdue_task_node_using_time_stamp(uint32_t time_stamp)
+// Emulate execution_time ticks of CPU work on the calling worker. The job
+// spins and counts the tick changes it sees while it is running, so time spent
+// preempted by the earliest deadline worker is not counted (to within one tick
+// per preemption). Nothing is allocated and no timer is involved, so a job
+// costs neither heap nor timer daemon commands. Every iteration is a
+// cancellation point, the job returns early once it has been aborted.
+static void emulate_dd_task_execution(dd_task_info_t *ptask_info)
 {
-	dd_task_node_t *pcurrent = pActive_list_head;
+	TickType_t last_tick = xTaskGetTickCount();
+	TickType_t current_tick;
+	uint32_t executed_ticks = 0;
+	uint32_t execution_ticks = (ptask_info->execution_time * jobEXECUTION_PERCENT) / 100;
 
-	if(pActive_list_head == NULL)
+	while((executed_ticks < execution_ticks) && !ptask_info->abort_requested)
 	{
-		return NULL;
-	}
+		current_tick = xTaskGetTickCount();
 
-	while(pcurrent->pnode->absolute_deadline < time_stamp)
-	{
-		if(pcurrent->pnext_node == NULL)
-		{
-			return NULL;
-		}
-		else
+		if(current_tick != last_tick)
 		{
-			pcurrent = pcurrent->pnext_node;
+			executed_ticks++;
+			last_tick = current_tick;
 		}
 	}
+}
+
+// Execute a periodic dd user-defined task, its LED is on for its execution time
+static void dd_user_defined_led_task(void *pvParameters)
+{
+	dd_task_info_t *pMy_task_info = (dd_task_info_t *)pvParameters;
+	Led_TypeDef led = (Led_TypeDef)pMy_task_info->pperiodic_task->led;
+	TaskHandle_t my_task_handle = xTaskGetCurrentTaskHandle();
+	uint32_t startTick;
+	uint32_t endTick;
 
-	return pcurrent;
+	startTick = xTaskGetTickCount();
+	STM_EVAL_LEDOn(led);
+	logINFO("dd_user_defined_led_task %u handle = %p: LED %d On.\n", (unsigned int)pMy_task_info->task_id, my_task_handle, led);
+
+	emulate_dd_task_execution(pMy_task_info);
+
+	endTick = xTaskGetTickCount();
+	STM_EVAL_LEDOff(led);
+	logINFO("dd_user_defined_led_task %u handle = %p, tick = %u: LED %d Off.\n", (unsigned int)pMy_task_info->task_id, my_task_handle, (unsigned int)(endTick - startTick), led);
 }
 
-// List of DD tasks that have completed execution before their deadlines
-// -	Remove completed tasks before their deadline from Active Task List
-// -	Add these completed tasks to Completed Task List
-dd_task_node_t *pRemove_completed_task_node_by_time_stamp(dd_task_info_t *ptask_info)
+// Execute the aperiodic dd user-defined task, red LED on for its execution time
+static void dd_user_defined_aperiodic_task(void *pvParameters)
 {
-	dd_task_node_t *pcurrent = pActive_list_head;
-	dd_task_node_t *pprevious = NULL;
+	dd_task_info_t *pMy_task_info = (dd_task_info_t *)pvParameters;
+
+	STM_EVAL_LEDOn(red_led);
+	logINFO("dd_user_defined_aperiodic_task deadline = %u: Red LED On.\n", (unsigned int)pMy_task_info->absolute_deadline);
+	emulate_dd_task_execution(pMy_task_info);
+	STM_EVAL_LEDOff(red_led);
+	logINFO("dd_user_defined_aperiodic_task: Red LED Off.\n");
+}
 
-	if(pActive_list_head == NULL)
+// Push Button Interrupt Handler, every press releases an aperiodic DD task
+void EXTI0_IRQHandler(void)
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	/* Make sure that interrupt flag is set */
+	if (EXTI_GetITStatus(EXTI_Line0) != RESET)
 	{
-		return NULL;
+		release_aperiodic_dd_task_from_isr(APERIODIC_TASK_ID, APERIODIC_TASK_EXECUTION_TIME, dd_user_defined_aperiodic_task, &xHigherPriorityTaskWoken);
+		/* Clear interrupt flag (Want to do this as late as possible to avoid triggering the IRQ in the IRQ) */
+		EXTI_ClearITPendingBit(EXTI_Line0);
+		portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
 	}
+}
 
-	while((pcurrent->pnode->completion_time) != ptask_info->completion_time)
+// Append a DD task to the tail of a bounded list. When the list is full the
+// oldest node is unlinked and both it and its task info go back to the pools.
+dd_task_node_t *insert_new_node_to_task_list(dd_task_list_t *ptask_list, dd_task_info_t *ptask_info)
+{
+	dd_task_node_t *ptemp;
+	dd_task_node_t *poldest;
+
+	if(ptask_list->length >= ptask_list->max_length)
 	{
-		// if it is the last node
-		if(pcurrent->pnext_node == NULL)
-		{
-			return NULL;
-		}
-		else
+		poldest = ptask_list->phead;
+		ptask_list->phead = poldest->pnext_node;
+
+		if(ptask_list->phead == NULL)
 		{
-			pprevious = pcurrent;
-			pcurrent = pcurrent->pnext_node;
+			ptask_list->ptail = NULL;
 		}
+
+		ptask_list->length--;
+		retire_dd_task_info(poldest->pnode);
+		dd_pool_free(&task_node_pool, (void *)poldest);
 	}
 
-	// found a match
-	if(pcurrent == pActive_list_head)
+	ptemp = (dd_task_node_t*)pvDd_pool_alloc(&task_node_pool); // create a new node
+
+	if(ptemp == NULL)
+	{
+		logERROR("insert_new_node_to_task_list: Error task node pool is empty!\n");
+		retire_dd_task_info(ptask_info);
+		return NULL;
+	}
+
+	ptemp->pnode = ptask_info;
+	ptemp->pnext_node = NULL;
+
+	if(ptask_list->ptail == NULL)
 	{
-		pActive_list_head = pActive_list_head->pnext_node;
+		ptask_list->phead = ptemp;
 	}
 	else
 	{
-		pprevious->pnext_node = pcurrent->pnext_node;
+		ptask_list->ptail->pnext_node = ptemp;
 	}
 
-	return pcurrent;
+	ptask_list->ptail = ptemp;
+	ptask_list->length++;
+
+	return ptemp;
 }
 
-dd_task_node_t *pRemove_overdue_task_node_by_time_stamp(uint32_t time_stamp)
+dd_task_node_t *insert_new_node_to_completed_list(dd_task_info_t *ptask_info)
 {
-	dd_task_node_t *pcurrent = pActive_list_head;
-	dd_task_node_t *pprevious = NULL;
+	return insert_new_node_to_task_list(&completed_task_list, ptask_info);
+}
 
-	if(pActive_list_head == NULL)
+dd_task_node_t *insert_new_node_to_overdue_list(dd_task_info_t *ptask_info)
+{
+	return insert_new_node_to_task_list(&overdue_task_list, ptask_info);
+}
+
+uint32_t active_list_length()
+{
+	return active_task_heap.length;
+}
+
+// active_dd_task_list
+// List of DD tasks to be scheduled by the DD scheduler
+// -	Kept as a binary min-heap on absolute deadline instead of a sorted linked list
+// -	Insert and remove are O(log n), the earliest deadline task is always at the root
+bool insert_task_to_active_heap(dd_task_info_t *ptask_info)
+{
+	if(!dd_heap_insert(&active_task_heap, ptask_info))
 	{
-		return NULL;
+		logERROR("insert_task_to_active_heap: Error active heap is full!\n");
+		return false;
 	}
 
-	while((pcurrent->pnode->absolute_deadline) < time_stamp)
+	return true;
+}
+
+dd_task_info_t *pPeek_earliest_deadline_task(void)
+{
+	return pDd_heap_peek(&active_task_heap);
+}
+
+dd_task_info_t *pRemove_task_from_active_heap(uint32_t heap_index)
+{
+	return pDd_heap_remove(&active_task_heap, heap_index);
+}
+
+// List of DD tasks that have completed execution before their deadlines
+// -	Remove completed tasks before their deadline from Active Task List
+// -	Add these completed tasks to Completed Task List
+// The task is found through its own heap_index, so removal is O(log n) with no search
+bool remove_completed_task_from_active_heap(dd_task_info_t *ptask_info)
+{
+	return dd_heap_remove_task(&active_task_heap, ptask_info);
+}
+
+// Remove the earliest deadline task if its deadline is at or before time_stamp,
+// call repeatedly to drain every overdue task
+dd_task_info_t *pRemove_overdue_task_by_time_stamp(uint32_t time_stamp)
+{
+	dd_task_info_t *pearliest = pPeek_earliest_deadline_task();
+
+	if((pearliest == NULL) || ((int32_t)(pearliest->absolute_deadline - time_stamp) > 0))
 	{
-		// if it is the last node
-		if(pcurrent->pnext_node == NULL)
-		{
-			return NULL;
-		}
-		else
-		{
-			pprevious = pcurrent;
-			pcurrent = pcurrent->pnext_node;
-		}
+		return NULL;
 	}
 
-	// found a match
-	if(pcurrent == pActive_list_head)
+	return pRemove_task_from_active_heap(0);
+}
+
+void printActiveList(dd_task_info_t *ptask_infos, uint32_t length)
+{
+	uint32_t index;
+
+	for(index = 0; index < length; index++)
 	{
-		pActive_list_head = pActive_list_head->pnext_node;
+		printf("Task handle = %p, release time = %u, deadline = %u\n", ptask_infos[index].task_handle, (unsigned int)ptask_infos[index].release_time, (unsigned int)ptask_infos[index].absolute_deadline);
 	}
-	else
+}
+
+void printCompletedList(dd_task_info_t *ptask_infos, uint32_t length)
+{
+	uint32_t index;
+
+	for(index = 0; index < length; index++)
 	{
-		pprevious->pnext_node = pcurrent->pnext_node;
+		printf("Task handle = %p, completion time = %u, execution = %u us, response = %u us, preemptions = %u\n",
+			ptask_infos[index].task_handle, (unsigned int)ptask_infos[index].completion_time,
+			(unsigned int)ulDd_cycles_to_us(ptask_infos[index].execution_cycles),
+			(unsigned int)ulDd_cycles_to_us(ptask_infos[index].completion_cycle - ptask_infos[index].release_cycle),
+			(unsigned int)ptask_infos[index].preemption_count);
 	}
-
-	return pcurrent;
 }
 
-void printActiveList()
+void printOverdueList(dd_task_info_t *ptask_infos, uint32_t length)
 {
-	dd_task_node_t *ptemp = pActive_list_head;
+	uint32_t index;
 
-	while(ptemp != NULL)
+	for(index = 0; index < length; index++)
 	{
-		printf("Task handle = 0x%x, release time = %d\n", ptemp->pnode->task_handle, ptemp->pnode->release_time);
-		ptemp = ptemp->pnext_node;
+		printf("Task handle = %p, overdue time = %u\n", ptask_infos[index].task_handle, (unsigned int)ptask_infos[index].overdue_time);
 	}
-
-	printf("dd_scheduler gets here?\n");
 }
 
-void printCompletedList()
+// Republish the active heap, in heap order, for the monitor
+void publish_active_snapshot(void)
 {
-	dd_task_node_t *ptemp = pCompletion_list_head;
+	uint32_t heap_index;
 
-	while(ptemp != NULL)
+	dd_snapshot_begin(&active_task_snapshot);
+
+	for(heap_index = 0; heap_index < active_task_heap.length; heap_index++)
 	{
-		printf("Task handle = 0x%x, completion time = %d\n", ptemp->pnode->task_handle, ptemp->pnode->completion_time);
-		ptemp = ptemp->pnext_node;
+		dd_snapshot_append(&active_task_snapshot, pActive_task_heap[heap_index]);
 	}
+
+	dd_snapshot_end(&active_task_snapshot);
 }
 
-void printOverdueList()
+// Republish a completed or overdue list, oldest first, for the monitor
+void publish_task_list_snapshot(dd_task_snapshot_t *psnapshot, dd_task_list_t *ptask_list)
 {
-	dd_task_node_t *ptemp = pOverdue_list_head;
+	dd_task_node_t *ptemp = ptask_list->phead;
+
+	dd_snapshot_begin(psnapshot);
 
 	while(ptemp != NULL)
 	{
-		printf("Task handle = 0x%x, overdue time = %d\n", ptemp->pnode->task_handle, ptemp->pnode->overdue_time);
+		dd_snapshot_append(psnapshot, ptemp->pnode);
 		ptemp = ptemp->pnext_node;
 	}
+
+	dd_snapshot_end(psnapshot);
+}
+
+void printPoolStatistics()
+{
+	printf("Task info pool: in use = %u, high water mark = %u/%u, failures = %u\n", (unsigned int)task_info_pool.in_use, (unsigned int)task_info_pool.high_water_mark, (unsigned int)task_info_pool.length, (unsigned int)task_info_pool.alloc_failures);
+	printf("Task node pool: in use = %u, high water mark = %u/%u, failures = %u\n", (unsigned int)task_node_pool.in_use, (unsigned int)task_node_pool.high_water_mark, (unsigned int)task_node_pool.length, (unsigned int)task_node_pool.alloc_failures);
+	printf("Scheduler: events = %u, wakeups = %u, ring overflows = %u, cycles per event = %u, longest batch = %u cycles\n",
+		(unsigned int)scheduler_event_count, (unsigned int)scheduler_wakeup_count, (unsigned int)dd_scheduler_event_ring.overflows,
+		(scheduler_event_count == 0) ? 0 : (unsigned int)(scheduler_busy_cycles / scheduler_event_count), (unsigned int)scheduler_max_batch_cycles);
+	printf("Log: level = %d, deferred = %d, dropped = %u\n", logLEVEL, logDEFERRED, (unsigned int)dd_log_ring.overflows);
+	printf("Admission: periodic utilization = %u/10000, aperiodic backlog = %u, rejections = %u, demand tests = %u\n",
+		(unsigned int)((dd_admission.periodic_utilization * 10000) >> admissionUTILIZATION_SHIFT), (unsigned int)dd_admission.aperiodic_backlog,
+		(unsigned int)admission_rejection_count, (unsigned int)dd_admission.demand_tests);
+	printf("Overrun: policy = %d, aborted = %u, skipped releases = %u\n", overrunPOLICY, (unsigned int)overrun_abort_count, (unsigned int)overrun_skipped_releases);
+	printf("Tickless idle: sleeps = %u, ticks suppressed = %u\n", (unsigned int)tickless_sleep_count, (unsigned int)tickless_suppressed_ticks);
 }
 
 // Execute deadline-driven scheduler task
 // 1.	Implements EDF algorithm
 // 2.	Control the priorities of users-define FreeRTOS tasks from an actively-managed list of DD tasks
+// Every wakeup drains all messages posted since the last one, then runs the EDF
+// dispatch, re-arms the deadline timer and republishes the changed lists once per batch
 void dd_task_scheduler(void *pvParameters)
 {
-	printf("dd_task_scheduler: print 1st\n");
+	logDEBUG("dd_task_scheduler: print 1st\n");
 	dd_message_t scheduler_message;
-	dd_task_node_t *pnode_with_completion_time = NULL;
-	dd_task_node_t *pnode_with_completion_time_removed = NULL;
-	dd_task_node_t *pnode_with_overdue_time = NULL;
-	dd_task_node_t *active_list = NULL;
-	dd_task_node_t *completed_list = NULL;
-	dd_task_node_t *overdue_list = NULL;
 
 	TickType_t release_time = 0;
-	//TickType_t aperodic_task_timer_period = 0;
-	TickType_t dd_task_completion_time = 0;
+	TickType_t current_time = 0;
+	uint32_t previous_server_deadline;
 	dd_task_info_t *ptask_info;
-	printf("dd_task_scheduler: print 2nd\n");
+	uint32_t batch_length;
+	bool active_list_changed;
+	bool completed_list_changed;
+	bool overdue_list_changed;
+	uint64_t batch_start_cycle;
+	uint32_t batch_cycles;
+	logDEBUG("dd_task_scheduler: print 2nd\n");
 
 	while(1)
 	{
-		printf("dd_task_scheduler waiting for message\n");
-		if(xQueueReceive(dd_scheduler_message_queue, &scheduler_message, portMAX_DELAY) == pdTRUE)
+		logDEBUG("dd_task_scheduler waiting for message\n");
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		batch_start_cycle = ullDd_cycle_count();
+		scheduler_wakeup_count++;
+		batch_length = 0;
+		active_list_changed = false;
+		completed_list_changed = false;
+		overdue_list_changed = false;
+
+		while(dd_ring_pop(&dd_scheduler_event_ring, &scheduler_message))
 		{
-			printf("Scheduler message type: %d\n", scheduler_message.message_type);
+			logDEBUG("Scheduler message type: %d\n", scheduler_message.message_type);
 			ptask_info = scheduler_message.ptask_info;
-
-			//		//ptask_info->release_time = release_time;
-			//		pnode_with_overdue_time = pFind_overdue_task_node_using_time_stamp(ptask_info->release_time);
-			//		printf("pnode_with_overdue_time = %d", );
-			//		overdue_list = insert_new_node_to_overdue_list(pnode_with_overdue_time->pnode);
-			//		pRemove_overdue_task_node_by_time_stamp(ptask_info->release_time);
-			//		sort_active_list_by_deadline(ptask_info);
-			//		vTaskPrioritySet(ptask_info->task_handle, tskIDLE_PRIORITY + 1);
-
-			//printf("dd_task_scheduler: print 3rd\n");
-
+			batch_length++;
 
 			switch(scheduler_message.message_type)
 			{
 			// If DDS receives message from release_dd_task
 			// then	DD scheduler:
 			// -	assigns release time for new task
-			// -	inserts DD task to Active task List
-			// -	sorts the list by deadline
-			// -	sets priorities of the User-Defined tasks
+			// -	assigns the Total Bandwidth Server deadline of an aperiodic task
+			// -	inserts DD task to Active task heap, ordered by deadline in O(log n)
+			// -	hands the DD task to an idle worker task
 			case RELEASE_TASK:
-				printf("dd_task_scheduler: task has been released\n");
+				logDEBUG("dd_task_scheduler: task has been released\n");
 				release_time = xTaskGetTickCount();
 				ptask_info->release_time = release_time;
-				printf("Task 0x%x, released time = %d\n", ptask_info->task_handle, ptask_info->release_time);
-				active_list = insert_new_node_to_active_list(ptask_info);
-				sort_active_list_by_deadline(ptask_info);
-				vTaskPrioritySet(ptask_info->task_handle, tskIDLE_PRIORITY + 1);
-				//xAperiodicTimer = xTimerCreate("AperiodicTaskTimer", execution_time, pdFALSE, aperiodictimer_id, vAperiodicTaskTimerCallBack);
-				//xTimerStart(xAperiodicTimer, pdMS_TO_TICKS(0));
-				vTaskResume(ptask_info->task_handle);
+				ptask_info->release_cycle = ullDd_cycle_count();
+
+				previous_server_deadline = aperiodic_server_deadline;
+
+				if(ptask_info->type == APERIODIC)
+				{
+					assign_aperiodic_deadline(ptask_info);
+				}
+
+				if(!admit_dd_task(ptask_info))
+				{
+					// A rejected aperiodic job gives its server bandwidth back
+					aperiodic_server_deadline = previous_server_deadline;
+					admission_rejection_count++;
+					dd_trace_record(TRACE_DD_REJECT, ptask_info->task_id, ptask_info->execution_time);
+					logWARN("Task %u rejected by admission control\n", (unsigned int)ptask_info->task_id);
+					delete_dd_task_info(ptask_info);
+					break;
+				}
+
+				if(!insert_task_to_active_heap(ptask_info))
+				{
+					// Admitted but never activated, the job gives its server bandwidth back too
+					if(ptask_info->type == APERIODIC)
+					{
+						aperiodic_server_deadline = previous_server_deadline;
+						dd_release_aperiodic_job(&dd_admission, ptask_info->execution_time);
+					}
+
+					delete_dd_task_info(ptask_info);
+					break;
+				}
+
+				dispatch_dd_task_to_worker(ptask_info);
+				dd_trace_record(TRACE_DD_RELEASE, ptask_info->task_id, ptask_info->absolute_deadline);
+				active_list_changed = true;
+				logINFO("Task %u, worker %p, released time = %u\n", (unsigned int)dd_task_info_index(ptask_info), ptask_info->task_handle, (unsigned int)ptask_info->release_time);
 				break;
 
 				// If DDS receives message from complete_dd_task
 				// then DD scheduler:
 				// -	assigns completion time to newly-completed DD task
-				// -	removes DD task from Active Task List
+				// -	removes DD task from Active Task heap, the heap stays ordered by deadline
 				// -	inserts it to the Completed Task List
-				// -	sorts Active Task List by deadline
-				// -	sets priorities of the User-Define tasks
+				// -	returns its worker task to the idle pool
 			case COMPLETED_TASK:
-				printf("dd_task_scheduler: task has been completed\n");
-				dd_task_completion_time = xTimerGetPeriod(ptask_info->timer_handle);
-				ptask_info->completion_time = dd_task_completion_time;
-				printf("Task 0x%x completion time %d \n", ptask_info->task_handle, ptask_info->completion_time);
-				pnode_with_completion_time = pFind_completed_task_node_by_time_stamp(ptask_info);
-				//printf("dd_scheduler gets here?\n");
-				completed_list = insert_new_node_to_completed_list(pnode_with_completion_time->pnode);
-				pnode_with_completion_time_removed = pRemove_completed_task_node_by_time_stamp(pnode_with_completion_time->pnode);
-				//delete_dd_task_info(pnode_with_completion_time_removed->pnode);
-				//sort_active_list_by_deadline(ptask_info);
-
-				//vTaskPrioritySet(ptask_info->task_handle, tskIDLE_PRIORITY + 1);
+				logDEBUG("dd_task_scheduler: task has been completed\n");
+				ptask_info->job_outstanding = false;
+				ptask_info->completion_time = xTaskGetTickCount();
+				dd_trace_record(TRACE_DD_COMPLETE, ptask_info->task_id, ptask_info->completion_time);
+				logINFO("Task %p completion time %u \n", ptask_info->task_handle, (unsigned int)ptask_info->completion_time);
 
-				break;
+				if(ptask_info->type == APERIODIC)
+				{
+					dd_release_aperiodic_job(&dd_admission, ptask_info->execution_time);
+				}
 
-				// If DDS receives message from get_active_dd_task_list
-				// then DD scheduler sends Active Task List to the monitor queue
-			case GET_ACTIVE_DD_TASK_LIST:
-				if(uxQueueSpacesAvailable(dd_monitor_message_queue) == 0)
+				if(ptask_info->state == TASK_ACTIVE)
 				{
-					xQueueReset(dd_monitor_message_queue);
+					if(remove_completed_task_from_active_heap(ptask_info))
+					{
+						ptask_info->state = TASK_COMPLETED;
+						insert_new_node_to_completed_list(ptask_info);
+						active_list_changed = true;
+						completed_list_changed = true;
+					}
 				}
 
-				xQueueSend(dd_monitor_message_queue, (void *)active_list, portMAX_DELAY);
+				release_dd_task_worker(ptask_info);
 
-				break;
-
-				// If DDS receives message from get_completed_dd_task_list
-				// then DDS sends Completed Task List to the monitor queue
-			case GET_COMPLETED_DD_TASK_LIST:
-				if(uxQueueSpacesAvailable(dd_monitor_message_queue) == 0)
+				// An overdue task that already fell off the overdue list is freed once its job is done
+				if(ptask_info->state == TASK_RETIRED)
 				{
-					xQueueReset(dd_monitor_message_queue);
+					delete_dd_task_info(ptask_info);
 				}
-
-				xQueueSend(dd_monitor_message_queue, (void *)completed_list, portMAX_DELAY);
 				break;
 
-				// Message from get_overdue_dd_task_list
-				// DD scheduler	sends Overdue Task List to a queue
-			case GET_OVERDUE_DD_TASK_lIST:
-				if(uxQueueSpacesAvailable(dd_monitor_message_queue) == 0)
+				// If DDS receives message from the deadline timer
+				// then DD scheduler:
+				// -	removes every DD task whose deadline has passed from the Active Task heap
+				// -	applies overrunPOLICY to each of them: abort the job, or let it run at the
+				//	lowest priority and possibly skip the next release of its task
+				// -	inserts them to the Overdue Task List
+			case OVERDUE_TASK:
+				logDEBUG("dd_task_scheduler: deadline timer expired\n");
+				current_time = xTaskGetTickCount();
+				deadline_timer_armed = false;
+
+				while((ptask_info = pRemove_overdue_task_by_time_stamp(current_time)) != NULL)
 				{
-					xQueueReset(dd_monitor_message_queue);
+					ptask_info->overdue_time = current_time;
+					ptask_info->state = TASK_OVERDUE;
+					dd_trace_record(TRACE_DD_OVERDUE, ptask_info->task_id, ptask_info->overdue_time);
+					logWARN("Task %p overdue time %u \n", ptask_info->task_handle, (unsigned int)ptask_info->overdue_time);
+					apply_overrun_policy(ptask_info);
+					insert_new_node_to_overdue_list(ptask_info);
+					active_list_changed = true;
+					overdue_list_changed = true;
 				}
-
-				xQueueSend(dd_monitor_message_queue, (void *)overdue_list, portMAX_DELAY);
 				break;
 
 			default:
-				printf("Error: Unrecognized message type %d!\n", scheduler_message.message_type);
+				logERROR("Error: Unrecognized message type %d!\n", scheduler_message.message_type);
 				break;
 			}
+		}
 
+		scheduler_event_count += batch_length;
 
+		// Once per batch: boost the worker of the earliest deadline DD task,
+		// re-arm the deadline timer and republish the lists that changed
+		dispatch_earliest_deadline_task();
+		arm_deadline_timer();
 
-//		//ptask_info->release_time = release_time;
-//		pnode_with_overdue_time = pFind_overdue_task_node_using_time_stamp(ptask_info->release_time);
-//		printf("pnode_with_overdue_time = %d", );
-//		overdue_list = insert_new_node_to_overdue_list(pnode_with_overdue_time->pnode);
-//		pRemove_overdue_task_node_by_time_stamp(ptask_info->release_time);
-//		sort_active_list_by_deadline(ptask_info);
-//		vTaskPrioritySet(ptask_info->task_handle, tskIDLE_PRIORITY + 1);
-
-		//printf("dd_task_scheduler: print 3rd\n");
-
-
-//		switch(scheduler_message.message_type)
-//		{
-//			// If DDS receives message from release_dd_task
-//			// then	DD scheduler:
-//			// -	assigns release time for new task
-//			// -	inserts DD task to Active task List
-//			// -	sorts the list by deadline
-//			// -	sets priorities of the User-Defined tasks
-//			case RELEASE_TASK:
-//				printf("dd_task_scheduler: task has been released\n");
-//				release_time = xTaskGetTickCount();
-//				ptask_info->release_time = release_time;
-//				printf("Task 0x%x, released time = %d\n", ptask_info->task_handle, ptask_info->release_time);
-//				active_list = insert_new_node_to_active_list(ptask_info);
-//				sort_active_list_by_deadline(ptask_info);
-//				vTaskPrioritySet(ptask_info->task_handle, tskIDLE_PRIORITY + 1);
-//				//xAperiodicTimer = xTimerCreate("AperiodicTaskTimer", execution_time, pdFALSE, aperiodictimer_id, vAperiodicTaskTimerCallBack);
-//				//xTimerStart(xAperiodicTimer, pdMS_TO_TICKS(0));
-//				vTaskResume(ptask_info->task_handle);
-//				break;
-//
-//			// If DDS receives message from complete_dd_task
-//			// then DD scheduler:
-//			// -	assigns completion time to newly-completed DD task
-//			// -	removes DD task from Active Task List
-//			// -	inserts it to the Completed Task List
-//			// -	sorts Active Task List by deadline
-//			// -	sets priorities of the User-Define tasks
-//			case COMPLETED_TASK:
-//				printf("dd_task_scheduler: task has been completed\n");
-//				dd_task_completion_time = xTimerGetPeriod(ptask_info->timer_handle);
-//				ptask_info->completion_time = dd_task_completion_time;
-//				printf("Task 0x%x completion time %d \n", ptask_info->task_handle, ptask_info->completion_time);
-//				pnode_with_completion_time = pFind_completed_task_node_by_time_stamp(ptask_info);
-//				completed_list = insert_new_node_to_completed_list(pnode_with_completion_time->pnode);
-//				pRemove_completed_task_node_by_time_stamp(pnode_with_completion_time->pnode);
-//				sort_active_list_by_deadline(ptask_info);
-//				vTaskPrioritySet(ptask_info->task_handle, tskIDLE_PRIORITY + 1);
-//				break;
-//
-//			// If DDS receives message from get_active_dd_task_list
-//			// then DD scheduler sends Active Task List to the monitor queue
-//			case GET_ACTIVE_DD_TASK_LIST:
-//				if(uxQueueSpacesAvailable(dd_monitor_message_queue) == 0)
-//				{
-//					xQueueReset(dd_monitor_message_queue);
-//				}
-//
-//				xQueueSend(dd_monitor_message_queue, (void *)active_list, portMAX_DELAY);
-//				break;
-//
-//			// If DDS receives message from get_completed_dd_task_list
-//			// then DDS sends Completed Task List to the monitor queue
-//			case GET_COMPLETED_DD_TASK_LIST:
-//				if(uxQueueSpacesAvailable(dd_monitor_message_queue) == 0)
-//				{
-//					xQueueReset(dd_monitor_message_queue);
-//				}
-//
-//				xQueueSend(dd_monitor_message_queue, (void *)completed_list, portMAX_DELAY);
-//				break;
-//
-//			// Message from get_overdue_dd_task_list
-//			// DD scheduler	sends Overdue Task List to a queue
-//			case GET_OVERDUE_DD_TASK_lIST:
-//				if(uxQueueSpacesAvailable(dd_monitor_message_queue) == 0)
-//				{
-//					xQueueReset(dd_monitor_message_queue);
-//				}
-//
-//				xQueueSend(dd_monitor_message_queue, (void *)overdue_list, portMAX_DELAY);
-//				break;
-//
-//			default:
-//				printf("Error: Unrecognized message type %d!\n", scheduler_message.message_type);
-//				break;
+		if(active_list_changed)
+		{
+			publish_active_snapshot();
 		}
-	}
-}
 
-// get_active_dd_task_list sends a message to a queue requesting Active Task List from DD scheduler
-// Once DD Scheduler responds, get_active_dd_task_list function returns the list
-dd_task_node_t **pGetActiveDDTaskList(void)
-{
-	dd_message_t request_active_dd_task_list_message;
-	request_active_dd_task_list_message.message_type = GET_ACTIVE_DD_TASK_LIST;
-	request_active_dd_task_list_message.ptask_list = NULL;
+		if(completed_list_changed)
+		{
+			publish_task_list_snapshot(&completed_task_snapshot, &completed_task_list);
+		}
+
+		if(overdue_list_changed)
+		{
+			publish_task_list_snapshot(&overdue_task_snapshot, &overdue_task_list);
+		}
 
-	xQueueSend(dd_scheduler_message_queue, (void*)&(request_active_dd_task_list_message.message_type), portMAX_DELAY);
+		batch_cycles = (uint32_t)(ullDd_cycle_count() - batch_start_cycle);
+		scheduler_busy_cycles += batch_cycles;
 
-	if(xQueueReceive(dd_monitor_message_queue, &(request_active_dd_task_list_message.ptask_list), portMAX_DELAY) == pdTRUE)
-	{
-		printActiveList();
+		if(batch_cycles > scheduler_max_batch_cycles)
+		{
+			scheduler_max_batch_cycles = batch_cycles;
+		}
 	}
+}
 
-	return 0;
+// get_active_dd_task_list
+// -	copies the Active Task List last published by the DD scheduler into ptask_infos
+// -	returns the number of DD tasks copied, never blocks the DD scheduler
+uint32_t get_active_dd_task_list(dd_task_info_t *ptask_infos, uint32_t max_length)
+{
+	return dd_snapshot_read(&active_task_snapshot, ptask_infos, max_length);
 }
 
 // get_completed_dd_task_list
-// -	send a message to a queue requesting Completed Task List from DD scheduler
-// Once DD Scheduler responds, get_completed_dd_task_list function returns the list
-dd_task_node_t **pGetCompletedDDTaskList(void)
+// -	copies the Completed Task List last published by the DD scheduler, oldest first
+uint32_t get_completed_dd_task_list(dd_task_info_t *ptask_infos, uint32_t max_length)
 {
-
-
-	dd_message_t request_complete_dd_task_list_message;
-	request_complete_dd_task_list_message.message_type = GET_COMPLETED_DD_TASK_LIST;
-	request_complete_dd_task_list_message.ptask_list = NULL;
-
-	xQueueSend(dd_scheduler_message_queue, (void *)&(request_complete_dd_task_list_message.message_type), portMAX_DELAY);
-
-	if(xQueueReceive(dd_monitor_message_queue, &(request_complete_dd_task_list_message.ptask_list), portMAX_DELAY) == pdTRUE)
-	{
-		printCompletedList();
-	}
-
-	return 0;
+	return dd_snapshot_read(&completed_task_snapshot, ptask_infos, max_length);
 }
 
 // get_overdue_dd_task_list
-// send a message to a queue requesting Overdue Task List from DD scheduler
-// Once DD Scheduler responds, get_overdue_dd_task_list function returns the list
-dd_task_node_t **pGetOverdueDDTaskList(void)
+// -	copies the Overdue Task List last published by the DD scheduler, oldest first
+uint32_t get_overdue_dd_task_list(dd_task_info_t *ptask_infos, uint32_t max_length)
 {
-	dd_message_t request_overdue_dd_task_list_message;
-	request_overdue_dd_task_list_message.message_type = GET_OVERDUE_DD_TASK_lIST;
-	request_overdue_dd_task_list_message.ptask_list = NULL;
-
-	xQueueSend(dd_scheduler_message_queue, (void *)&(request_overdue_dd_task_list_message.message_type), portMAX_DELAY);
-
-	if(xQueueReceive(dd_monitor_message_queue, &(request_overdue_dd_task_list_message.ptask_list), portMAX_DELAY) == pdTRUE)
-	{
-		printOverdueList();
-	}
-
-	return 0;
+	return dd_snapshot_read(&overdue_task_snapshot, ptask_infos, max_length);
 }
 
-// This task displays traffic light system and car on the road by updating the LEDs using the shift register
+// Periodically print the three DD task lists from their snapshots.
+// The copies are static, they are too large for the monitor stack.
 void dd_task_monitor(void *pvParameters)
 {
+	static dd_task_info_t task_infos[activeHEAP_LENGTH];
+	uint32_t length;
+
 	vTaskDelay(10000);
 	while(1)
 	{
 		printf("dd_task_monitor: Active Task List\n");
-		pGetActiveDDTaskList();
-//		printf("dd_task_monitor: Completed Task List\n");
-//		pGetCompletedDDTaskList();
-//		printf("dd_task_monitor: Overdue Task List\n");
-//		pGetOverdueDDTaskList();
-		//vTaskDelay(100);
+		length = get_active_dd_task_list(task_infos, activeHEAP_LENGTH);
+		printActiveList(task_infos, length);
+		printf("dd_task_monitor: Completed Task List\n");
+		length = get_completed_dd_task_list(task_infos, activeHEAP_LENGTH);
+		printCompletedList(task_infos, length);
+		printf("dd_task_monitor: Overdue Task List\n");
+		length = get_overdue_dd_task_list(task_infos, activeHEAP_LENGTH);
+		printOverdueList(task_infos, length);
+		printPoolStatistics();
+		vTaskDelay(monitorPERIOD);
 	}
 }
 
@@ -1090,6 +1481,29 @@ void vApplicationIdleHook(void)
 	}
 }
 
+#if configUSE_TICKLESS_IDLE != 0
+// Tickless idle, called by the idle task with the scheduler suspended when the
+// kernel expects to stay idle for expected_idle_time ticks. The generator
+// blocks until the next periodic release and the deadline timer is armed for
+// the earliest active deadline, so the kernel's next unblock time already
+// bounds the sleep by both; this only counts the sleeps for the monitor.
+//
+// Defining portSUPPRESS_TICKS_AND_SLEEP in FreeRTOSConfig.h also drops the
+// port's declaration of its own implementation, which is called from here
+extern void vPortSuppressTicksAndSleep(TickType_t xExpectedIdleTime);
+
+void dd_suppress_ticks_and_sleep(uint32_t expected_idle_time)
+{
+	TickType_t current_time = xTaskGetTickCount();
+
+	vPortSuppressTicksAndSleep(expected_idle_time);
+
+	// The port steps the tick count over the ticks it slept through
+	tickless_sleep_count++;
+	tickless_suppressed_ticks += xTaskGetTickCount() - current_time;
+}
+#endif /* configUSE_TICKLESS_IDLE */
+
 static void prvSetupHardware(void)
 {
 	/* Ensure all priority bits are assigned as preemption priority bits.
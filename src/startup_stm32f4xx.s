@@ -55,6 +55,10 @@ defined in linker script */
 .word  _sbss
 /* end address for the .bss section. defined in linker script */
 .word  _ebss
+/* start address for the .ccmbss section. defined in linker script */
+.word  _sccmbss
+/* end address for the .ccmbss section. defined in linker script */
+.word  _eccmbss
 /* stack used for SystemInit_ExtMemCtl; always internal RAM used */
 
 /**
@@ -98,6 +102,17 @@ LoopFillZerobss:
   ldr  r3, = _ebss
   cmp  r2, r3
   bcc  FillZerobss
+  ldr  r2, =_sccmbss
+  b  LoopFillZeroccmbss
+/* Zero fill the .ccmbss section in CCM RAM. */
+FillZeroccmbss:
+  movs  r3, #0
+  str  r3, [r2], #4
+
+LoopFillZeroccmbss:
+  ldr  r3, = _eccmbss
+  cmp  r2, r3
+  bcc  FillZeroccmbss
 
 /* Call the clock system intitialization function.*/
   bl  SystemInit   
@@ -11,7 +11,7 @@
 **                conversion specifier.
 **
 **                The following conversion specifiers are supported
-**                cdisuxX%
+**                cdisuxXp%
 **
 **                Usage:
 **                c    character
@@ -19,6 +19,7 @@
 **                s    character string
 **                u    unsigned integer as decimal
 **                x,X  unsigned integer as hexadecimal (uppercase letter)
+**                p    pointer as 0x and hexadecimal
 **                %    % is written (conversion specification is '%%')
 **
 **                Note:
@@ -42,6 +43,7 @@
 
 /* Includes */
 #include <stdarg.h>
+#include <stdint.h>
 #include <stdio.h>
 
 /* External function prototypes (defined in syscalls.c) */
@@ -125,6 +127,11 @@ int ts_formatstring(char *buf, const char *fmt, va_list va)
 			  case 'X':
 					ts_itoa(&buf, va_arg(va, int), 16);
 				break;
+			  case 'p':
+					*buf++ = '0';
+					*buf++ = 'x';
+					ts_itoa(&buf, (unsigned int)(uintptr_t)va_arg(va, void *), 16);
+				break;
 			  case '%':
 				  *buf++ = '%';
 				  break;
@@ -184,6 +191,11 @@ int ts_formatlength(const char *fmt, va_list va)
 				  length += 8;
 				  va_arg(va, unsigned int);
 				  break;
+			  case 'p':
+				  /* 0x and 32 bits pointer as hex */
+				  length += 10;
+				  va_arg(va, void *);
+				  break;
 			  default:
 				  ++length;
 				  break;